@@ -0,0 +1,210 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Static.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+//  Benchmarks of indexing and traversal, for the layouts with an index equation, Static vs Dynamic, EfficientShape and
+//  size types. Results are printed as JSON. Build with optimization (e.g. -DCMAKE_BUILD_TYPE=Release), and optionally
+//  give the side of the cubes: IrulanBench [n].
+//      traverse    sum of the data through a pointer, the baseline bandwidth
+//      index       sum with A(i, j, k), in memory order
+//      partial     sum with A(j, k) per line along the fastest index, and the line through a pointer
+//      random      sum with A(i, j, k) at random valid indexes, the cost of the index equation itself
+
+using namespace Irulan;
+
+constexpr std::size_t n = 128;
+
+//  Keeps the compiler from optimizing away a result.
+
+template <typename T>
+void keep(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
+
+//  Seconds per call of f, the best of some runs that each take long enough to measure.
+
+template <typename F>
+double measure(F f)
+{   using Clock = std::chrono::steady_clock;
+    f();
+    std::size_t calls = 1;
+    double best = 1e300;
+    for (int run = 0; run < 5; run++)
+    {   while (true)
+        {   const auto start = Clock::now();
+            for (std::size_t i = 0; i < calls; i++)
+                f();
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            if (seconds > 0.02)
+            {   best = std::min(best, seconds / calls);
+                break;
+            }
+            calls *= 2;
+        }
+    }
+    return best;
+}
+
+
+
+//  First and end of the fastest index in line (j, k).
+
+template <LayoutEnum layout>
+std::uint32_t first(std::uint32_t j, std::uint32_t) noexcept
+{   return layout == packed_dec ? j : 0;
+}
+
+template <LayoutEnum layout>
+std::uint32_t last(std::uint32_t j, std::size_t m) noexcept
+{   return layout == packed_inc ? j + 1 : m;
+}
+
+//  Valid indexes (fastest first), in memory order, for column major cubes of side m.
+
+template <LayoutEnum layout>
+std::vector<std::array<std::uint32_t, 3>> indexes(std::size_t m)
+{   std::vector<std::array<std::uint32_t, 3>> result;
+    for (std::uint32_t k = 0; k < m; k++)
+        for (std::uint32_t j = first<layout>(k, k); j < last<layout>(k, m); j++)
+            for (std::uint32_t i = first<layout>(j, k); i < last<layout>(j, m); i++)
+                result.push_back({i, j, k});
+    return result;
+}
+
+struct Result
+{   std::string benchmark, array, layout, size_type;
+    bool efficient_shape;
+    std::size_t side, elements;
+    double seconds;
+};
+
+std::vector<Result> results;
+
+//  Start of line (j, k) through a partial index, which is a sub-array for Static and an element for Dynamic.
+
+template <typename Array>
+const auto *line(const Array& A, std::uint32_t j, std::uint32_t k) noexcept
+{   if constexpr (std::is_pointer_v<decltype(A())> && std::is_reference_v<decltype(A(j, k))>
+        && std::is_same_v<std::remove_reference_t<decltype(A(j, k))>, std::remove_pointer_t<decltype(A())>>)
+        return &A(j, k);
+    else
+        return A(j, k)();
+}
+
+template <LayoutEnum layout, bool efficient_shape, typename Array>
+void run(const std::string& array, const std::string& size_type, Array& A, std::size_t size, std::size_t m)
+{   using value_type = std::remove_pointer_t<decltype(A())>;
+    const std::string layout_name = layout == conventional ? "conventional" : layout == packed_inc ? "packed_inc" : "packed_dec";
+
+    const auto all = indexes<layout>(m);
+    for (std::size_t i = 0; i < size; i++)
+        A()[i] = static_cast<value_type>(i % 7);
+    auto add = [&](const char *benchmark, std::size_t elements, double seconds)
+        {   results.push_back({benchmark, array, layout_name, size_type, efficient_shape, m, elements, seconds});
+        };
+
+    add("traverse", size, measure([&]()
+        {   value_type sum = 0;
+            const value_type *p = A();
+            for (std::size_t i = 0; i < size; i++)
+                sum += p[i];
+            keep(sum);
+        }));
+
+    add("index", all.size(), measure([&]()
+        {   value_type sum = 0;
+            for (std::uint32_t k = 0; k < m; k++)
+                for (std::uint32_t j = first<layout>(k, k); j < last<layout>(k, m); j++)
+                    for (std::uint32_t i = first<layout>(j, k); i < last<layout>(j, m); i++)
+                        sum += A(i, j, k);
+            keep(sum);
+        }));
+
+    add("partial", all.size(), measure([&]()
+        {   value_type sum = 0;
+            for (std::uint32_t k = 0; k < m; k++)
+                for (std::uint32_t j = first<layout>(k, k); j < last<layout>(k, m); j++)
+                {   const value_type *p = line(A, j, k);
+                    for (std::uint32_t i = first<layout>(j, k); i < last<layout>(j, m); i++)
+                        sum += p[i];
+                }
+            keep(sum);
+        }));
+
+    std::vector<std::array<std::uint32_t, 3>> random = all;
+    std::shuffle(random.begin(), random.end(), std::mt19937 {42});
+    random.resize(std::min<std::size_t>(random.size(), 1 << 16));
+    add("random", random.size(), measure([&]()
+        {   value_type sum = 0;
+            for (const auto& [i, j, k] : random)
+                sum += A(i, j, k);
+            keep(sum);
+        }));
+}
+
+
+
+template <LayoutEnum layout, bool efficient_shape, typename size_type>
+void run_dynamic(const std::string& size_type_name, std::size_t m)
+{   using Array = Dynamic::Array<float[3], Layout<layout>, EfficientShape<efficient_shape>, SizeType<size_type>>;
+    if constexpr (layout == conventional)
+    {   Array A {m, m, m};
+        run<layout, efficient_shape>("Dynamic", size_type_name, A, Array::data_size(m, m, m), m);
+    }
+    else
+    {   Array A {m};
+        run<layout, efficient_shape>("Dynamic", size_type_name, A, Array::data_size(m), m);
+    }
+}
+
+template <LayoutEnum layout>
+void run_static()
+{   using Array = Static::Array<float[n][n][n], Layout<layout>>;
+    const auto A = std::make_unique<Array>();
+    run<layout, false>("Static", "", *A, Array::size(), n);
+}
+
+int main(int argc, char **argv)
+{   const std::size_t m = argc > 1 ? std::strtoul(argv[1], NULL, 10) : n;
+
+    run_static<conventional>();
+    run_static<packed_inc>();
+    run_static<packed_dec>();
+    run_dynamic<conventional, false, std::size_t>("size_t", m);
+    run_dynamic<packed_inc, false, std::size_t>("size_t", m);
+    run_dynamic<packed_dec, false, std::size_t>("size_t", m);
+    run_dynamic<conventional, true, std::size_t>("size_t", m);
+    run_dynamic<packed_inc, true, std::size_t>("size_t", m);
+    run_dynamic<packed_dec, true, std::size_t>("size_t", m);
+    run_dynamic<conventional, false, std::uint32_t>("uint32_t", m);
+    run_dynamic<packed_inc, false, std::uint32_t>("uint32_t", m);
+    run_dynamic<packed_dec, false, std::uint32_t>("uint32_t", m);
+    run_dynamic<conventional, false, std::uint16_t>("uint16_t", m);
+
+    std::printf("{\n    \"benchmarks\": [\n");
+    for (std::size_t i = 0; i < results.size(); i++)
+    {   const Result& r = results[i];
+        std::printf("        {\"benchmark\": \"%s\", \"array\": \"%s\", \"layout\": \"%s\", \"efficient_shape\": %s, "
+            "\"size_type\": \"%s\", \"side\": %zu, \"elements\": %zu, \"seconds\": %.6g, \"ns_per_element\": %.4g, \"gb_per_s\": %.4g}%s\n",
+            r.benchmark.c_str(), r.array.c_str(), r.layout.c_str(), r.efficient_shape ? "true" : "false",
+            r.size_type.c_str(), r.side, r.elements, r.seconds, r.seconds * 1e9 / r.elements,
+            r.elements * sizeof(float) / r.seconds * 1e-9, i + 1 != results.size() ? "," : "");
+    }
+    std::printf("    ]\n}\n");
+}
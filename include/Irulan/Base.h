@@ -24,9 +24,18 @@
 
 #pragma once
 #include <cstddef>
+#include <cstdint>
 #include <array>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include "Type.h"
+#include "Memory.h"
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace Irulan
 {
@@ -170,12 +179,23 @@ protected:
 
     //  Using the extractor.
 
-    static constexpr LayoutEnum layout          = Extractor<LayoutBase,         Layout<conventional>> ::type::value;
-    static constexpr AxisEnum   axis            = Extractor<AxisBase,           Axis<column>>         ::type::value;
-    static constexpr bool       allocate        = Extractor<AllocateBase,       Allocate<true>>       ::type::value;
-    static constexpr bool       efficient_shape = Extractor<EfficientShapeBase, EfficientShape<false>>::type::value;
-    static constexpr std::array dims             {Extractor<ShapeBase, double>::dims};
+    static constexpr LayoutEnum  layout          = Extractor<LayoutBase,         Layout<conventional>> ::type::value;
+    static constexpr AxisEnum    axis            = Extractor<AxisBase,           Axis<column>>         ::type::value;
+    static constexpr bool        allocate        = Extractor<AllocateBase,       Allocate<true>>       ::type::value;
+    static constexpr bool        efficient_shape = Extractor<EfficientShapeBase, EfficientShape<false>>::type::value;
+    static constexpr bool        first_touch     = Extractor<FirstTouchBase,     FirstTouch<false>>    ::type::value;
+    static constexpr std::size_t inline_capacity = Extractor<InlineCapacityBase, InlineCapacity<0>>::type::value;
+    static constexpr bool        checked         = Extractor<CheckedBase,        Checked<false>>       ::type::value;
+    static constexpr bool        instrumented    = Extractor<InstrumentedBase,   Instrumented<false>>  ::type::value;
+    static constexpr bool        growable        = Extractor<GrowableBase,       Growable<false>>      ::type::value;
+    static constexpr std::size_t alignment       = Extractor<AlignmentBase,
+                                                       Alignment<__STDCPP_DEFAULT_NEW_ALIGNMENT__>>  ::type::value;
+    static constexpr std::array  tile            = Extractor<TileBase,           Tile<>>               ::type::value;
+    static constexpr std::size_t lanes           = Extractor<LanesBase,          Lanes<8>>             ::type::value;
+    static constexpr std::array  extents         = Extractor<ExtentsBase,        Extents<>>            ::type::value;
+    static constexpr std::array  dims             {Extractor<ShapeBase, double>::dims};
     using value_type = typename Extractor<ShapeBase, double>::value_type;
+    using allocator_type = typename Extractor<AllocatorBase, Allocator<HeapAllocator>>::type::template type<value_type, alignment>;
 
 
 
@@ -196,6 +216,42 @@ protected:
 
 
 
+protected:
+
+    //  Replace the property that inherits from PropertyBase by Property (or add it if there is none), and give the resulting
+    //  Properties to a template, e.g. to get the Allocate<false> version of a Dynamic::Array.
+
+    template <typename PropertyBase, typename Property>
+    struct Replacer
+    {
+        template <typename ...A>
+        struct List
+        {
+        };
+
+        //  The 1st template argument holds the properties kept so far, the rest the ones still to filter.
+
+        template <typename, typename ...>
+        struct Filter;
+
+        template <typename ...A>
+        struct Filter<List<A...>>
+        {   template <template <typename ...> typename Target>
+            using type = Target<A..., Property>;
+        };
+
+        template <typename ...A, typename B, typename ...C>
+        struct Filter<List<A...>, B, C...>
+            : std::conditional_t<std::is_base_of_v<PropertyBase, B>, Filter<List<A...>, C...>, Filter<List<A..., B>, C...>>
+        {
+        };
+
+        template <template <typename ...> typename Target>
+        using type = typename Filter<List<>, Properties...>::template type<Target>;
+    };
+
+
+
 protected:
 
     //  Combinations function (n choose k) needed for the size of packed Arrays.
@@ -210,6 +266,65 @@ protected:
 
 
 
+protected:
+
+    //  Index math is written for the index that runs fastest through memory coming first, i.e. column major. Row major is
+    //  the same with the indexes reversed, which this function does at compile time before handing them to f.
+
+    template <typename F, typename ...I>
+    static constexpr auto fastest_first(F f, I... i)
+    {   if constexpr (axis == column)
+            return f(i...);
+        else
+            return reversed(f, std::tuple {i...}, std::make_index_sequence<sizeof...(i)> {});
+    }
+
+    template <typename F, typename Tuple, std::size_t ...n>
+    static constexpr auto reversed(F f, const Tuple& i, std::index_sequence<n...>)
+    {   return f(std::get<sizeof...(n) - 1 - n>(i)...);
+    }
+
+
+
+protected:
+
+    //  Runtime index check for Checked. dim(l) gives the dim of index[l], or dyn if it isn't known. For a full index of a
+    //  packed layout, the indexes must also be ordered as the triangle requires (increasing fastest first for packed_inc).
+
+    template <bool full, typename Dim, std::size_t n>
+    static constexpr void check_index(Dim dim, const std::array<std::size_t, n>& index)
+    {   for (std::size_t l = 0; l < n; l++)
+            if (dim(l) != dyn && index[l] >= dim(l))
+                throw std::out_of_range {"index " + std::to_string(index[l]) + " of dim " + std::to_string(l)
+                    + " is out of range " + std::to_string(dim(l))};
+        if constexpr (full && (layout == packed_inc || layout == packed_dec))
+            for (std::size_t l = 1; l < n; l++)
+            {   const std::size_t a = index[axis == column ? l - 1 : n - l];
+                const std::size_t b = index[axis == column ? l : n - 1 - l];
+                if (layout == packed_inc ? a > b : a < b)
+                    throw std::out_of_range {"indexes are outside the triangle of the packed layout"};
+            }
+    }
+
+
+
+protected:
+
+    //  Strides of the conventional layout, in elements. The dim of the slowest index isn't used.
+
+    template <std::size_t order>
+    static constexpr std::array<std::ptrdiff_t, order> strides(const std::array<size_type, order>& dims) noexcept
+    {   std::array<std::ptrdiff_t, order> result {};
+        for (std::size_t i = 0; i < order; i++)
+        {   const std::size_t level = axis == column ? i : order - 1 - i;
+            const std::size_t prev  = axis == column ? i - 1 : order - i;
+            result[level] = i == 0 ? 1 : result[prev] * static_cast<std::ptrdiff_t>(dims[prev]);
+        }
+        return result;
+    }
+
+
+
 protected:
 
     //  Helper functions for packed indexing.
@@ -228,20 +343,6 @@ protected:
                 return (i + a) * A_inc<a + 1, b>(i);
         }
 
-        //  Evaluates part of a more complicate factorial-like expression.
-
-        template <std::size_t a, std::size_t b, typename I>
-        static auto A_dec(size_type n, I i)
-        {   if constexpr (b == 0)
-                return i;
-            else if constexpr (a == b)
-                return a - 2 + 2 * n - i;
-            else if constexpr (a == 0)
-                return i * A_dec<a + 1, b>(n, i);
-            else
-                return (a - 2 + 2 * n - i) * A_dec<a + 1, b>(n, i);
-        }
-
         //  Divides by part of a factorial.
 
         template <std::size_t b, typename I>
@@ -267,19 +368,240 @@ protected:
                 return B<a>(A_inc<0, a>(i)) + C_inc<a + 1>(j...);
         }
 
-        //  Index solution for decreasing packed data:
-        //        i
-        //      + j * (2 * n - j - 1) / 2
-        //      + k * (2 * n - k - 1) * (2 * n - k) / (2 * 3)
-        //      + l * (2 * n - l - 1) * (2 * n - l) * (2 * n - l + 1) / (2 * 3 * 4)
-        //      + ...
+        //  Index solution for decreasing packed data, which is increasing packed data backwards, with the indexes counted
+        //  from the other end:
+        //        combinations(n + order - 1, order) - 1
+        //      - C_inc(n - 1 - i, n - 1 - j, n - 1 - k, ...)
+        //  For order 2 this is i + j * (2 * n - j - 1) / 2.
 
-        template <std::size_t a, typename I, typename ...J>
+        template <typename I, typename ...J>
         static auto C_dec(size_type n, I i, J... j)
+        {   return B<sizeof...(j)>(A_inc<0, sizeof...(j)>(n)) - 1 - C_inc<0>(n - 1 - i, (n - 1 - j)...);
+        }
+    };
+
+
+
+protected:
+
+    //  Helper functions for tiled indexing. The dims are given as a function of the level, the indexes fastest first (see
+    //  fastest_first), as for the other layouts. With the tile shape known at compile time, the divisions and modulos are by
+    //  constants, and for tiles that are powers of 2 they're shifts and masks.
+
+    struct TiledIndexing
+    {
+        //  Level of the index at some position when the indexes are ordered fastest first.
+
+        template <std::size_t position>
+        static constexpr std::size_t level = axis == column ? position : tile.size() - 1 - position;
+
+        //  Number of elements in a tile.
+
+        static constexpr std::size_t tile_size = []()
+            {   std::size_t result = 1;
+                for (std::size_t length : tile)
+                    result *= length;
+                return result;
+            }();
+
+        //  Number of tiles along the dim of some level.
+
+        template <typename D>
+        static constexpr std::size_t tiles(const D& dims, std::size_t level) noexcept
+        {   return (dims(level) + tile[level] - 1) / tile[level];
+        }
+
+        //  Number of elements in memory, which is that of all tiles, including the parts that stick out.
+
+        template <typename D>
+        static constexpr std::size_t size(const D& dims, std::size_t order) noexcept
+        {   std::size_t result = tile_size;
+            for (std::size_t i = 0; i < order; i++)
+                result *= tiles(dims, i);
+            return result;
+        }
+
+        //  Index of the tile the element is in.
+
+        template <std::size_t position, typename D, typename I, typename ...J>
+        static constexpr auto C_tile(const D& dims, I i, J... j) noexcept
         {   if constexpr (sizeof...(j) == 0)
-                return B<a>(A_dec<0, a>(n, i));
+                return i / tile[level<position>];
+            else
+                return i / tile[level<position>] + tiles(dims, level<position>) * C_tile<position + 1>(dims, j...);
+        }
+
+        //  Index of the element within its tile.
+
+        template <std::size_t position, typename I, typename ...J>
+        static constexpr auto C_elem(I i, J... j) noexcept
+        {   if constexpr (sizeof...(j) == 0)
+                return i % tile[level<position>];
+            else
+                return i % tile[level<position>] + tile[level<position>] * C_elem<position + 1>(j...);
+        }
+
+        template <typename D, typename ...I>
+        static constexpr auto C(const D& dims, I... i) noexcept
+        {   return C_tile<0>(dims, i...) * tile_size + C_elem<0>(i...);
+        }
+    };
+
+
+
+protected:
+
+    //  Helper functions for Morton (Z-order) indexing. The index is the interleaving of the bits of the indexes, the 1st bit
+    //  of the fastest index is the 1st bit of the index. The data is a cube with sides a power of 2, so the index doesn't
+    //  depend on the dims.
+
+    struct MortonIndexing
+    {
+        //  Number of elements in memory, for the largest dim.
+
+        static constexpr std::size_t size(std::size_t dim, std::size_t order) noexcept
+        {   std::size_t bits = 0;
+            while ((std::size_t {1} << bits) < dim)
+                bits++;
+            return std::size_t {1} << (bits * order);
+        }
+
+        //  Bits at every n-th position.
+
+        template <std::size_t n>
+        static constexpr std::uint64_t mask = []()
+            {   std::uint64_t result = 0;
+                for (std::size_t i = 0; i < 64; i += n)
+                    result |= std::uint64_t {1} << i;
+                return result;
+            }();
+
+        //  Spread the bits of i so that there are n - 1 zeros in between. With BMI2 this is a single PDEP instruction.
+
+        template <std::size_t n>
+        static std::uint64_t spread(std::uint64_t i) noexcept
+        {
+#if defined(__BMI2__)
+            return _pdep_u64(i, mask<n>);
+#else
+            if constexpr (n == 1)
+                return i;
+            else if constexpr (n == 2)
+            {   i &= 0x00000000ffffffff;
+                i = (i | i << 16) & 0x0000ffff0000ffff;
+                i = (i | i << 8)  & 0x00ff00ff00ff00ff;
+                i = (i | i << 4)  & 0x0f0f0f0f0f0f0f0f;
+                i = (i | i << 2)  & 0x3333333333333333;
+                i = (i | i << 1)  & 0x5555555555555555;
+                return i;
+            }
+            else if constexpr (n == 3)
+            {   i &= 0x00000000001fffff;
+                i = (i | i << 32) & 0x001f00000000ffff;
+                i = (i | i << 16) & 0x001f0000ff0000ff;
+                i = (i | i << 8)  & 0x100f00f00f00f00f;
+                i = (i | i << 4)  & 0x10c30c30c30c30c3;
+                i = (i | i << 2)  & 0x1249249249249249;
+                return i;
+            }
             else
-                return B<a>(A_dec<0, a>(n, i)) + C_dec<a + 1>(n, j...);
+            {   std::uint64_t result = 0;
+                for (std::size_t bit = 0; bit * n < 64; bit++)
+                    result |= (i >> bit & 1) << bit * n;
+                return result;
+            }
+#endif
+        }
+
+        template <typename ...I, std::size_t ...position>
+        static std::size_t C(std::index_sequence<position...>, I... i) noexcept
+        {   return ((spread<sizeof...(i)>(i) << position) | ...);
+        }
+
+        template <typename ...I>
+        static std::size_t C(I... i) noexcept
+        {   return C(std::make_index_sequence<sizeof...(i)> {}, i...);
+        }
+    };
+
+
+
+protected:
+
+    //  Helpers for aosoa indexing. The value type is a template of the member type, V<S>, with only members of type S.
+    //  Indexing gives a V<S&> (or V<const S&>) of the members of an element, in a Reference that can also be assigned and
+    //  converted from and to V<S> as a whole.
+
+    template <typename T>
+    struct Members
+    {   static_assert(sizeof(T) == 0, "the aosoa layout needs a value type that's a template of its member type");
+    };
+
+    template <template <typename> typename V, typename S>
+    struct Members<V<S>>
+    {   using type = S;
+        template <typename U>
+        using rebind = V<U>;
+    };
+
+    struct AoSoAIndexing
+    {   using member_type = typename Members<value_type>::type;
+        template <typename U>
+        using rebind = typename Members<value_type>::template rebind<U>;
+
+        static constexpr std::size_t members = sizeof(value_type) / sizeof(member_type);
+
+        static_assert(std::is_standard_layout_v<value_type> && sizeof(value_type) == members * sizeof(member_type),
+            "the aosoa layout needs a value type with only members of its member type");
+
+        //  Member type S or const S.
+
+        template <typename S>
+        struct Reference : rebind<S&>
+        {
+        private:
+
+            S *p;
+
+            template <std::size_t ...m>
+            Reference(S *p, std::index_sequence<m...>) noexcept
+                : rebind<S&> {p[m * lanes]...}, p {p}
+            {
+            }
+
+        public:
+
+            explicit Reference(S *p) noexcept
+                : Reference {p, std::make_index_sequence<members> {}}
+            {
+            }
+
+            Reference(const Reference&) noexcept = default;
+
+            operator value_type() const noexcept
+            {   value_type value;
+                for (std::size_t m = 0; m < members; m++)
+                    reinterpret_cast<member_type *>(&value)[m] = p[m * lanes];
+                return value;
+            }
+
+            const Reference& operator=(const value_type& value) const noexcept
+            {   for (std::size_t m = 0; m < members; m++)
+                    p[m * lanes] = reinterpret_cast<const member_type *>(&value)[m];
+                return *this;
+            }
+
+            const Reference& operator=(const Reference& A) const noexcept
+            {   return *this = static_cast<value_type>(A);
+            }
+        };
+
+        //  Reference to the element at memory index i, in the block of i / lanes, at lane i % lanes.
+
+        template <typename T>
+        static auto at(T *data, std::size_t i) noexcept
+        {   using S = std::conditional_t<std::is_const_v<T>, const member_type, member_type>;
+            return Reference<S> {reinterpret_cast<S *>(data) + i / lanes * lanes * members + i % lanes};
         }
     };
 };
@@ -0,0 +1,193 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include "Dynamic.h"
+
+namespace Irulan
+{
+
+//  Many Dynamic::Arrays of the same type and dims in one allocation, e.g. for batched kernels on small matrices. The dims
+//  are stored once, and the data is allocated with the allocator of Array.
+//  Without interleaving the arrays follow each other, and B[b] is a wrapper (Allocate<false>) of Array b, so it's used
+//  like any Array. Their stride is rounded up so that each starts at the alignment of Array. With interleaving element
+//  k of Array b is at k * count() + b, so the same element of all arrays is contiguous, for kernels that vectorize over
+//  the batch. B[b] is then an Interleaved view, which only indexes.
+
+template <typename Array, bool interleaved = false>
+struct Batch
+{
+
+public:
+
+    using value_type     = typename Array::value_type;
+    using size_type      = typename Array::size_type;
+    using wrapper_type   = typename Array::wrapper_type;
+    using allocator_type = typename Array::allocator_type;
+    static constexpr std::size_t order = Array::order;
+
+    static_assert(!interleaved || Array::layout != aosoa, "the aosoa layout already interleaves, don't interleave batches");
+
+
+
+public:
+
+    //  Index view of Array b in an interleaved Batch. Dims and indexes are those of Array.
+
+    struct Interleaved
+    {
+
+    private:
+
+        wrapper_type shape;
+        value_type *data;
+        std::size_t count;
+
+        friend Batch;
+
+        Interleaved(const wrapper_type& shape, value_type *data, std::size_t count) noexcept
+            : shape {shape}, data {data}, count {count}
+        {
+        }
+
+
+
+    public:
+
+        template <typename I>
+        decltype(auto) operator[](I i) const noexcept
+        {   return shape[i];
+        }
+
+        template <typename ...I>
+        value_type& operator()(I... i) const noexcept(!Array::checked)
+        {   return data[(&shape(i...) - shape()) * count];
+        }
+    };
+
+
+
+private:
+
+    //  The dims, with as data the start of the allocation too.
+
+    wrapper_type shape;
+    value_type *data;
+    std::size_t count_;
+    std::size_t stride_;
+
+
+
+public:
+
+    //  A Batch of count Arrays with dims as given to the constructor of Array. The data isn't initialized.
+
+    template <typename ...Dims>
+    Batch(std::size_t count, Dims... dims)
+        : shape {dims...}, data {NULL}, count_ {count}, stride_ {Array::data_size(dims...)}
+    {   if constexpr (!interleaved)
+        {   constexpr std::size_t step = std::lcm(Array::alignment, sizeof(value_type)) / sizeof(value_type);
+            stride_ = (stride_ + step - 1) / step * step;
+        }
+        data = allocator_type::allocate(count_ * stride_);
+        shape() = data;
+    }
+
+    Batch(const Batch&) = delete;
+
+    Batch(Batch&& B) noexcept
+        : shape {B.shape}, data {B.data}, count_ {B.count_}, stride_ {B.stride_}
+    {   B.data = NULL;
+        B.count_ = 0;
+    }
+
+    Batch& operator=(const Batch&) = delete;
+
+    Batch& operator=(Batch&& B) noexcept
+    {   if (this != &B)
+        {   free();
+            shape = B.shape;
+            data = B.data;
+            count_ = B.count_;
+            stride_ = B.stride_;
+            B.data = NULL;
+            B.count_ = 0;
+        }
+        return *this;
+    }
+
+    ~Batch() noexcept
+    {   free();
+    }
+
+
+
+private:
+
+    void free() noexcept
+    {   if (data != NULL)
+            allocator_type::deallocate(data);
+    }
+
+
+
+public:
+
+    //  Number of Arrays, and the number of elements each takes in memory, including padding up to the alignment.
+
+    std::size_t count() const noexcept
+    {   return count_;
+    }
+
+    std::size_t stride() const noexcept
+    {   return stride_;
+    }
+
+    //  All data, count() * stride() elements.
+
+    value_type *operator()() const noexcept
+    {   return data;
+    }
+
+    std::size_t size() const noexcept
+    {   return count_ * stride_;
+    }
+
+    //  Array b.
+
+    auto operator[](std::size_t b) const noexcept
+    {   if constexpr (interleaved)
+            return Interleaved {shape, data + b, count_};
+        else
+        {   wrapper_type A {shape};
+            A() = data + b * stride_;
+            return A;
+        }
+    }
+};
+
+}
@@ -0,0 +1,468 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Type.h"
+
+namespace Irulan
+{   namespace Convert
+    {
+
+//  Conversion between arrays of any layout and axis (except aosoa), e.g. unpacking a packed matrix into a conventional one
+//  for a library call and packing the result again.
+//      copy(A, B[, symmetric])     sets every element of B to the element of A at the same indexes
+//      in_place<B>(A)              converts an owning Dynamic::Array to type B in its own memory, where sizes allow
+//  Both have the same order and dims (all equal to the one dim of packed layouts), or std::invalid_argument is thrown.
+//  Elements of B whose indexes are outside the triangle of a packed A are left as they are, unless symmetric is set, then
+//  they're taken from the index with the same values in the order of the triangle (e.g. (j, i) for (i, j)).
+//  copy traverses the index space in blocks, split recursively until both parts fit in the L1 cache, so it's cache
+//  oblivious for transposes too. Within a block it copies lines along the fastest index of B, which are SIMD loops with
+//  a fixed stride in A when its layout allows (conventional, or packed along its own fastest index).
+
+
+
+template <typename A, typename = void>
+struct IsEfficient : std::false_type
+{
+};
+
+template <typename A>
+struct IsEfficient<A, std::enable_if_t<A::efficient_shape>> : std::true_type
+{
+};
+
+constexpr bool packed(LayoutEnum layout) noexcept
+{   return layout == packed_inc || layout == packed_dec;
+}
+
+//  Dims of an array, with the one dim of packed layouts for every level.
+
+template <typename Array>
+std::array<std::size_t, Array::order> dims_of(const Array& A) noexcept
+{   static_assert(!IsEfficient<Array>::value || (packed(Array::layout) && Array::order > 1),
+        "the dims of the array must be known");
+    std::array<std::size_t, Array::order> dims;
+    for (std::size_t level = 0; level < Array::order; level++)
+        dims[level] = A[packed(Array::layout) ? 0 : level];
+    return dims;
+}
+
+
+
+template <typename A, typename B>
+struct Engine
+{
+
+private:
+
+    static constexpr std::size_t order = B::order;
+    static_assert(A::order == order, "arrays of a conversion must have the same order");
+    static_assert(A::layout != aosoa && B::layout != aosoa, "elements of the aosoa layout aren't stored as a whole");
+
+    using Index = std::array<std::size_t, order>;
+
+    //  Level of the index at some position, fastest first.
+
+    template <typename Array>
+    static constexpr std::size_t level(std::size_t position) noexcept
+    {   return Array::axis == column ? position : order - 1 - position;
+    }
+
+    template <typename Array>
+    static constexpr std::size_t position(std::size_t level) noexcept
+    {   return Array::axis == column ? level : order - 1 - level;
+    }
+
+    //  Whether data along the fastest index of B is contiguous, and whether A has a fixed stride along it.
+
+    static constexpr std::size_t fast = level<B>(0);
+    static constexpr bool b_lines = B::layout == conventional || packed(B::layout);
+    static constexpr bool a_lines = A::layout == conventional || (packed(A::layout) && level<A>(0) == fast);
+
+    //  Elements per block, so that a block of A and B fit a 32 KiB L1 cache.
+
+    static constexpr std::size_t block = std::max<std::size_t>((1 << 14) / sizeof(typename B::value_type), 64);
+
+    const A& a;
+    B& b;
+    bool symmetric;
+    Index dims;
+
+
+
+public:
+
+    //  Whether an index is in the triangle of a packed layout (always for the others).
+
+    template <typename Array>
+    static bool valid(const Index& index) noexcept
+    {   for (std::size_t p = 1; p < order; p++)
+        {   const std::size_t faster = index[level<Array>(p - 1)], slower = index[level<Array>(p)];
+            if ((Array::layout == packed_inc && faster > slower) || (Array::layout == packed_dec && faster < slower))
+                return false;
+        }
+        return true;
+    }
+
+    //  The index with the same values, ordered as the triangle of a packed A requires.
+
+    static Index sorted(const Index& index) noexcept
+    {   Index values = index, result;
+        if constexpr (A::layout == packed_inc)
+            std::sort(values.begin(), values.end());
+        else
+            std::sort(values.begin(), values.end(), [](std::size_t i, std::size_t j){ return i > j; });
+        for (std::size_t p = 0; p < order; p++)
+            result[level<A>(p)] = values[p];
+        return result;
+    }
+
+    Engine(const A& a, B& b, bool symmetric)
+        : a {a}, b {b}, symmetric {symmetric}, dims {dims_of(b)}
+    {   if (dims_of(a) != dims)
+            throw std::invalid_argument {"arrays of a conversion must have the same dims"};
+    }
+
+    void run()
+    {   Index begin {}, index {};
+        split(begin, dims, index);
+    }
+
+
+
+private:
+
+    //  Halve the widest dim of the box [begin, end) until it's a block.
+
+    void split(const Index& begin, const Index& end, Index& index)
+    {   std::size_t volume = 1, widest = 0;
+        for (std::size_t level = 0; level < order; level++)
+        {   volume *= end[level] - begin[level];
+            if (end[level] - begin[level] > end[widest] - begin[widest])
+                widest = level;
+        }
+        if (volume == 0)
+            return;
+        if (volume <= block || end[widest] - begin[widest] == 1)
+            return loop<order - 1>(begin, end, index);
+        Index middle = end;
+        middle[widest] = begin[widest] + (end[widest] - begin[widest]) / 2;
+        split(begin, middle, index);
+        Index begin_ = begin;
+        begin_[widest] = middle[widest];
+        split(begin_, end, index);
+    }
+
+    //  Loop over the positions of B from the slowest down, clipped by its triangle. The fastest one is a line.
+
+    template <std::size_t p>
+    void loop(const Index& begin, const Index& end, Index& index)
+    {   constexpr std::size_t l = level<B>(p);
+        std::size_t lo = begin[l], hi = end[l];
+        if constexpr (p + 1 < order && B::layout == packed_inc)
+            hi = std::min(hi, index[level<B>(p + 1)] + 1);
+        if constexpr (p + 1 < order && B::layout == packed_dec)
+            lo = std::max(lo, index[level<B>(p + 1)]);
+        if constexpr (p == 0)
+            line(index, lo, hi);
+        else
+            for (index[l] = lo; index[l] < hi; index[l]++)
+                loop<p - 1>(begin, end, index);
+    }
+
+    void line(Index& index, std::size_t lo, std::size_t hi)
+    {   if constexpr (packed(A::layout))
+        {   if (symmetric)
+            {   for (index[fast] = lo; index[fast] < hi; index[fast]++)
+                    std::apply(b, index) = std::apply(a, valid<A>(index) ? index : sorted(index));
+                return;
+            }
+            //  Clip to the triangle of A, in which the fastest index of B lies between its neighbours in A.
+            constexpr std::size_t p = position<A>(fast);
+            if constexpr (p != 0)
+            {   const std::size_t x = index[level<A>(p - 1)];
+                if constexpr (A::layout == packed_inc)
+                    lo = std::max(lo, x);
+                else
+                    hi = std::min(hi, x + 1);
+            }
+            if constexpr (p + 1 < order)
+            {   const std::size_t x = index[level<A>(p + 1)];
+                if constexpr (A::layout == packed_inc)
+                    hi = std::min(hi, x + 1);
+                else
+                    lo = std::max(lo, x);
+            }
+            if (lo >= hi)
+                return;
+            index[fast] = lo;
+            if (!valid<A>(index))
+                return;
+        }
+        if (lo >= hi)
+            return;
+        if constexpr (b_lines && a_lines)
+        {   index[fast] = lo;
+            auto *d = &std::apply(b, index);
+            const auto *s = &std::apply(a, index);
+            std::ptrdiff_t stride = 1;
+            if constexpr (A::layout == conventional)
+                if (hi - lo > 1)
+                {   index[fast] = lo + 1;
+                    stride = &std::apply(a, index) - s;
+                }
+            const std::ptrdiff_t n = hi - lo;
+            if (stride == 1)
+            {
+#if defined(_OPENMP)
+                #pragma omp simd
+#endif
+                for (std::ptrdiff_t x = 0; x < n; x++)
+                    d[x] = s[x];
+            }
+            else
+            {
+#if defined(_OPENMP)
+                #pragma omp simd
+#endif
+                for (std::ptrdiff_t x = 0; x < n; x++)
+                    d[x] = s[x * stride];
+            }
+        }
+        else
+            for (index[fast] = lo; index[fast] < hi; index[fast]++)
+                std::apply(b, index) = std::apply(a, index);
+    }
+};
+
+
+
+template <typename A, typename B>
+void copy(const A& a, B& b, bool symmetric = false)
+{   Engine<A, B> {a, b, symmetric}.run();
+}
+
+
+
+//  In place conversion of an owning Dynamic::Array a to type B, which takes over its data, so a is left empty. Possible
+//  when the data of B fits in that of a, and it can be written in the same order as a is read:
+//      the same layout and axis (only the type changes)
+//      conventional to packed, with the same axis
+//      conventional of order 2 with equal dims to conventional of the other axis, a transpose in blocks
+
+//  Call f(index) for the indexes of a packed layout with dims n in memory order, from the slowest position down.
+
+template <typename B, std::size_t p, typename Index, typename F>
+void walk(std::size_t n, Index& index, F& f)
+{   constexpr std::size_t order = B::order;
+    constexpr std::size_t l = B::axis == column ? p : order - 1 - p;
+    constexpr std::size_t outer = B::axis == column ? p + 1 : order - 2 - p;
+    std::size_t lo = 0, hi = n;
+    if constexpr (p + 1 < order && B::layout == packed_inc)
+        hi = index[outer] + 1;
+    if constexpr (p + 1 < order && B::layout == packed_dec)
+        lo = index[outer];
+    for (index[l] = lo; index[l] < hi; index[l]++)
+        if constexpr (p == 0)
+            f(index);
+        else
+            walk<B, p - 1>(n, index, f);
+}
+
+template <typename B, typename A>
+typename B::owner_type in_place(A& a)
+{   static_assert(std::is_same_v<typename A::allocator_type, typename B::allocator_type>,
+        "in place conversion needs the same allocator");
+    static_assert(A::order == B::order, "arrays of a conversion must have the same order");
+    static_assert((A::layout == B::layout && A::axis == B::axis)
+        || (A::layout == conventional && packed(B::layout) && A::axis == B::axis)
+        || (A::layout == conventional && B::layout == conventional && A::order == 2),
+        "in place conversion is only possible for the same layout, conventional to packed, or transposes");
+    const auto dims = dims_of(a);
+    if constexpr (A::layout == conventional && packed(B::layout))
+    {   for (std::size_t level = 1; level < A::order; level++)
+            if (dims[level] != dims[0])
+                throw std::invalid_argument {"packed arrays have equal sides"};
+        //  Packed memory order is conventional memory order with indexes left out, so the writes trail the reads.
+        auto *data = a();
+        std::size_t k = 0;
+        std::array<std::size_t, A::order> index {};
+        auto f = [&](const auto& index_){ data[k++] = std::apply(a, index_); };
+        walk<B, A::order - 1>(dims[0], index, f);
+    }
+    else if constexpr (A::axis != B::axis)
+    {   if (dims[0] != dims[1])
+            throw std::invalid_argument {"in place transposes need equal dims"};
+        const std::size_t n = dims[0], tile = 32;
+        for (std::size_t i0 = 0; i0 < n; i0 += tile)
+            for (std::size_t j0 = i0; j0 < n; j0 += tile)
+                for (std::size_t i = i0; i < std::min(i0 + tile, n); i++)
+                    for (std::size_t j = std::max(j0, i + 1); j < std::min(j0 + tile, n); j++)
+                        std::swap(a(i, j), a(j, i));
+    }
+    typename B::wrapper_type W = [&]()
+        {   if constexpr (packed(B::layout))
+                return typename B::wrapper_type {dims[0]};
+            else
+                return std::apply([](auto... dims_){ return typename B::wrapper_type {dims_...}; }, dims);
+        }();
+    W() = a.release()();
+    return B::owner_type::adopt(W);
+}
+
+
+
+//  Permutation of the axes of a conventional array a into b (an array or view), as numpy.transpose: dim l of b is dim
+//  axes[l] of a, and b(i[axes[0]], i[axes[1]], ...) = a(i[0], i[1], ...). E.g. axes {1, 0} transposes a matrix.
+//  If the fastest dim of b is the fastest of a, lines are copied as they are. Otherwise data goes through square tiles of
+//  the two fastest dims, read along one and written along the other, so both stay in cache. The tiles and the other
+//  dims are split over threads with OpenMP.
+
+template <typename A, typename B>
+void permute(const A& a, B& b, const std::array<std::size_t, A::order>& axes)
+{   constexpr std::size_t order = A::order;
+    static_assert(B::order == order, "arrays of a permutation must have the same order");
+    static_assert(A::layout == conventional && B::layout == conventional, "permutations are of conventional arrays");
+    const auto dims_a = dims_of(a), dims_b = dims_of(b);
+    std::array<bool, order> seen {};
+    for (std::size_t l = 0; l < order; l++)
+    {   if (axes[l] >= order || seen[axes[l]])
+            throw std::invalid_argument {"axes must be a permutation"};
+        seen[axes[l]] = true;
+        if (dims_b[l] != dims_a[axes[l]])
+            throw std::invalid_argument {"dims of a permutation don't match"};
+    }
+    for (std::size_t l = 0; l < order; l++)
+        if (dims_a[l] == 0)
+            return;
+
+    //  Strides in elements, per dim of a, for both.
+
+    const std::array<std::size_t, order> zero {};
+    const auto *s = &std::apply(a, zero);
+    auto *d = &std::apply(b, zero);
+    std::array<std::ptrdiff_t, order> stride_a {}, stride_b {};
+    for (std::size_t l = 0; l < order; l++)
+        if (dims_b[l] > 1)
+        {   std::array<std::size_t, order> index {};
+            index[axes[l]] = 1;
+            stride_a[axes[l]] = &std::apply(a, index) - s;
+            index = {};
+            index[l] = 1;
+            stride_b[axes[l]] = &std::apply(b, index) - d;
+        }
+
+    //  The fastest dims of a and b, as dims of a, and the others.
+
+    const std::size_t p = A::axis == column ? 0 : order - 1;
+    const std::size_t q = axes[B::axis == column ? 0 : order - 1];
+    std::array<std::size_t, order> outer {};
+    std::size_t n_outer = 0, count = 1;
+    for (std::size_t l = 0; l < order; l++)
+        if (l != p && l != q)
+        {   outer[n_outer++] = l;
+            count *= dims_a[l];
+        }
+    auto offsets = [&](std::size_t i, std::ptrdiff_t& offset_a, std::ptrdiff_t& offset_b)
+        {   offset_a = offset_b = 0;
+            for (std::size_t o = 0; o < n_outer; o++)
+            {   const std::size_t l = outer[o], x = i % dims_a[l];
+                i /= dims_a[l];
+                offset_a += static_cast<std::ptrdiff_t>(x) * stride_a[l];
+                offset_b += static_cast<std::ptrdiff_t>(x) * stride_b[l];
+            }
+        };
+
+    const std::ptrdiff_t sa = stride_a[p], sb = stride_b[p];
+    if (p == q)
+    {   const std::ptrdiff_t n = dims_a[p], count_ = count;
+#if defined(_OPENMP)
+        #pragma omp parallel for schedule(static)
+#endif
+        for (std::ptrdiff_t i = 0; i < count_; i++)
+        {   std::ptrdiff_t offset_a, offset_b;
+            offsets(i, offset_a, offset_b);
+            const auto *s_ = s + offset_a;
+            auto *d_ = d + offset_b;
+#if defined(_OPENMP)
+            #pragma omp simd
+#endif
+            for (std::ptrdiff_t x = 0; x < n; x++)
+                d_[x * sb] = s_[x * sa];
+        }
+        return;
+    }
+
+    constexpr std::size_t tile = 16;
+    const std::size_t n_p = dims_a[p], n_q = dims_a[q], tiles_q = (n_q + tile - 1) / tile;
+    const std::ptrdiff_t ta = stride_a[q], tb = stride_b[q], tasks = count * tiles_q;
+#if defined(_OPENMP)
+    #pragma omp parallel for schedule(static)
+#endif
+    for (std::ptrdiff_t task = 0; task < tasks; task++)
+    {   std::ptrdiff_t offset_a, offset_b;
+        offsets(task / tiles_q, offset_a, offset_b);
+        const std::size_t q0 = task % tiles_q * tile, q1 = std::min(q0 + tile, n_q);
+        for (std::size_t p0 = 0; p0 < n_p; p0 += tile)
+        {   const std::size_t p1 = std::min(p0 + tile, n_p);
+            for (std::size_t y = p0; y < p1; y++)
+            {   const auto *s_ = s + offset_a + static_cast<std::ptrdiff_t>(y) * sa;
+                auto *d_ = d + offset_b + static_cast<std::ptrdiff_t>(y) * sb;
+#if defined(_OPENMP)
+                #pragma omp simd
+#endif
+                for (std::size_t x = q0; x < q1; x++)
+                    d_[static_cast<std::ptrdiff_t>(x) * tb] = s_[static_cast<std::ptrdiff_t>(x) * ta];
+            }
+        }
+    }
+}
+
+//  With the axes at compile time, which are checked then.
+
+template <std::size_t ...axes, typename A, typename B>
+void permute(const A& a, B& b)
+{   static_assert(sizeof...(axes) == A::order, "give an axis per dim");
+    static_assert([]()
+        {   constexpr std::array<std::size_t, sizeof...(axes)> axes_ {axes...};
+            for (std::size_t l = 0; l < axes_.size(); l++)
+            {   if (axes_[l] >= axes_.size())
+                    return false;
+                for (std::size_t m = 0; m < l; m++)
+                    if (axes_[m] == axes_[l])
+                        return false;
+            }
+            return true;
+        }(), "axes must be a permutation");
+    permute(a, b, {axes...});
+}
+
+    }
+}
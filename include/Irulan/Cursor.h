@@ -0,0 +1,218 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include "Type.h"
+
+namespace Irulan
+{
+
+//  Cursor into an Array, for loops that step one index at a time, e.g. the inner loop of a contraction over a packed Array.
+//  Instead of evaluating the index solution (see Base::PackedIndexing) for every element, it keeps the memory index and
+//  updates it with additions only.
+//  The memory index is a sum of a polynomial per index, of degree 1 for conventional data and of degree position + 1 for
+//  packed data (position being that of the index when ordered fastest first). A polynomial of degree d at consecutive
+//  points is found from its forward differences, by adding each difference to the one below, d additions in total. The
+//  differences at index 0 are kept too, so that an index can be reset to 0 just as cheaply.
+
+template <typename Array, typename T>
+struct Cursor
+{
+
+private:
+
+    static constexpr LayoutEnum  layout = Array::layout;
+    static constexpr AxisEnum    axis   = Array::axis;
+    static constexpr std::size_t order  = Array::order;
+    using size_type = typename Array::size_type;
+
+    static_assert(layout == conventional || layout == packed_inc || layout == packed_dec,
+        "cursors only exist for layouts with an index solution that's a sum of a polynomial per index");
+
+    //  Degree of the polynomial of the index at some level.
+
+    static constexpr std::size_t degree(std::size_t level) noexcept
+    {   if constexpr (layout == conventional)
+            return 1;
+        else
+            return (axis == column ? level : order - 1 - level) + 1;
+    }
+
+    using Differences = std::array<std::ptrdiff_t, order + 1>;
+
+
+
+private:
+
+    T *data;
+    std::ptrdiff_t offset;
+    std::array<size_type, order> dims;
+    std::array<size_type, order> index {};
+    std::array<Differences, order> differences;
+    std::array<Differences, order> differences_0;
+
+
+
+public:
+
+    //  For packed layouts only the 1st dim is used. The cursor starts at index 0 for all levels.
+
+    Cursor(T *data, const std::array<size_type, order>& dims) noexcept
+        : data {data}, offset {0}, dims {dims}
+    {   offset = constant();
+        for (std::size_t level = 0; level < order; level++)
+        {   differences_0[level] = differences_at(level, 0);
+            differences[level] = differences_0[level];
+            offset += differences[level][0];
+        }
+    }
+
+
+
+public:
+
+    T& operator*() const noexcept
+    {   return data[offset];
+    }
+
+    //  Memory index of the current element.
+
+    std::ptrdiff_t memory_index() const noexcept
+    {   return offset;
+    }
+
+    template <std::size_t level>
+    size_type get() const noexcept
+    {   static_assert(level < order, "level must be less than order");
+        return index[level];
+    }
+
+
+
+public:
+
+    //  Step an index up.
+
+    template <std::size_t level>
+    void next() noexcept
+    {   static_assert(level < order, "level must be less than order");
+        constexpr std::size_t d = degree(level);
+        Differences& a = differences[level];
+        offset += a[1];
+        for (std::size_t m = 0; m < d; m++)
+            a[m] += a[m + 1];
+        index[level]++;
+    }
+
+    //  Step an index down.
+
+    template <std::size_t level>
+    void prev() noexcept
+    {   static_assert(level < order, "level must be less than order");
+        constexpr std::size_t d = degree(level);
+        Differences& a = differences[level];
+        for (std::size_t m = d; m-- > 0;)
+            a[m] -= a[m + 1];
+        offset -= a[1];
+        index[level]--;
+    }
+
+    //  Set an index back to 0.
+
+    template <std::size_t level>
+    void reset() noexcept
+    {   static_assert(level < order, "level must be less than order");
+        offset += differences_0[level][0] - differences[level][0];
+        differences[level] = differences_0[level];
+        index[level] = 0;
+    }
+
+    //  Set an index to any value. This evaluates the polynomial, so it's meant for the start of a loop, e.g. for packed_dec
+    //  where the fastest index starts at the next one.
+
+    template <std::size_t level>
+    void set(size_type i) noexcept
+    {   static_assert(level < order, "level must be less than order");
+        Differences a = differences_at(level, i);
+        offset += a[0] - differences[level][0];
+        differences[level] = a;
+        index[level] = i;
+    }
+
+
+
+private:
+
+    //  Binomial coefficient, also for negative n, which stays exact when calculated this way.
+
+    static constexpr std::ptrdiff_t combinations(std::ptrdiff_t n, std::size_t k) noexcept
+    {   std::ptrdiff_t result = 1;
+        for (std::size_t i = 0; i < k; i++)
+            result = result * (n - static_cast<std::ptrdiff_t>(i)) / static_cast<std::ptrdiff_t>(i + 1);
+        return result;
+    }
+
+    //  The part of the memory index that doesn't depend on any index.
+
+    std::ptrdiff_t constant() const noexcept
+    {   if constexpr (layout == packed_dec)
+            return combinations(static_cast<std::ptrdiff_t>(dims[0] + order - 1), order) - 1;
+        else
+            return 0;
+    }
+
+    //  The polynomial of the index at some level, see Base::PackedIndexing.
+
+    std::ptrdiff_t polynomial(std::size_t level, std::ptrdiff_t i) const noexcept
+    {   const std::size_t position = axis == column ? level : order - 1 - level;
+        if constexpr (layout == conventional)
+        {   std::ptrdiff_t stride = 1;
+            for (std::size_t p = 0; p < position; p++)
+                stride *= dims[axis == column ? p : order - 1 - p];
+            return i * stride;
+        }
+        else if constexpr (layout == packed_inc)
+            return combinations(i + position, position + 1);
+        else if constexpr (layout == packed_dec)
+            return -combinations(static_cast<std::ptrdiff_t>(dims[0]) - 1 - i + position, position + 1);
+    }
+
+    //  Forward differences of the polynomial of some level at some index.
+
+    Differences differences_at(std::size_t level, std::ptrdiff_t i) const noexcept
+    {   const std::size_t d = degree(level);
+        Differences result {};
+        for (std::size_t m = 0; m <= d; m++)
+            result[m] = polynomial(level, i + m);
+        for (std::size_t m = 1; m <= d; m++)
+            for (std::size_t p = d; p >= m; p--)
+                result[p] -= result[p - 1];
+        return result;
+    }
+};
+
+}
@@ -23,7 +23,13 @@
 */
 
 #pragma once
+#include <algorithm>
+#include <functional>
 #include "Base.h"
+#include "View.h"
+#include "Iterator.h"
+#include "Cursor.h"
+#include "Statistics.h"
 
 namespace Irulan
 {   namespace Dynamic
@@ -47,8 +53,18 @@ public:
           Base_::axis,
           Base_::allocate,
           Base_::efficient_shape,
+          Base_::alignment,
+          Base_::first_touch,
+          Base_::inline_capacity,
+          Base_::tile,
+          Base_::extents,
+          Base_::lanes,
+          Base_::checked,
+          Base_::instrumented,
+          Base_::growable,
           typename Base_::size_type,
-          typename Base_::value_type;
+          typename Base_::value_type,
+          typename Base_::allocator_type;
     static constexpr std::size_t order = Base_::dims[0];
 
 
@@ -57,6 +73,54 @@ private:
 
     static constexpr std::size_t stored_order = Base_::dims[0] - (efficient_shape ? 1 : 0);
 
+    //  Dims fixed by Extents, which aren't stored. The others are stored in order.
+
+    static constexpr bool is_fixed(std::size_t i) noexcept
+    {   return Base_::extents.size() != 0 && Base_::extents[i] != dyn;
+    }
+
+    static constexpr std::size_t fixed_dims = []()
+        {   std::size_t result = 0;
+            for (std::size_t i = 0; i < Base_::dims[0]; i++)
+                result += is_fixed(i);
+            return result;
+        }();
+
+    static constexpr std::size_t stored_index(std::size_t i) noexcept
+    {   std::size_t result = 0;
+        for (std::size_t j = 0; j < i; j++)
+            result += !is_fixed(j);
+        return result;
+    }
+
+    static constexpr std::size_t stored_dims = stored_order - fixed_dims;
+
+    //  The dim EfficientShape doesn't store is the one of the slowest index, which is the 1st for row major. Dims are
+    //  stored from dims_offset on.
+
+    static constexpr std::size_t dims_offset =
+        efficient_shape && axis == row && (layout == conventional || layout == tiled || layout == morton || layout == aosoa) ?
+        1 : 0;
+
+    //  Whether the data size can be calculated from the stored dims. Not so if EfficientShape dropped a dim that's needed.
+
+    static constexpr bool size_known =
+        !efficient_shape || ((layout == packed_inc || layout == packed_dec) && stored_order != 0);
+
+
+
+public:
+
+    //  The versions of this Array that do and don't own their data. Ownership can be handed between both.
+
+    using owner_type   = std::conditional_t<allocate, Array,
+        typename Base_::template Replacer<AllocateBase, Allocate<true>>::template type<Dynamic::Array>>;
+    using wrapper_type = std::conditional_t<!allocate, Array,
+        typename Base_::template Replacer<AllocateBase, Allocate<false>>::template type<Dynamic::Array>>;
+
+    template <typename ...>
+    friend struct Array;
+
 
 
 private:
@@ -64,13 +128,73 @@ private:
     //  Some early compile time checks for incorrect use.
 
     static_assert(Base_::dims.size() == 1, "dynamic arrays template their order, and should only have one");
+    static_assert(Base_::extents.size() == 0 || Base_::extents.size() == order, "extents need one per dim");
+    static_assert(fixed_dims == 0 || !efficient_shape, "fixed extents aren't stored anyway, don't use EfficientShape");
+    static_assert(fixed_dims == 0 || (layout != packed_inc && layout != packed_dec),
+        "packed arrays have a single dim, it can't be fixed");
+    static_assert(!growable || layout == conventional, "only the conventional layout can grow");
+    static_assert(!growable || !efficient_shape, "growable arrays need the dim they grow along, don't use EfficientShape");
+    static_assert(!growable || !is_fixed(axis == column ? order - 1 : 0), "the dim growable arrays grow along can't be fixed");
+
+
+
+private:
+
+    //  Stands in for the copied Array where arrays own their data, it's never defined.
+
+    struct Uncopyable;
 
 
 
 private:
 
-    template <size_t n_dims>
-    struct Data
+    //  Storage for InlineCapacity, a base of Data so that it takes no space without. Its elements aren't initialized.
+    //  It's aligned as Alignment says, up to cache lines.
+
+    static constexpr std::size_t buffer_capacity = allocate ? inline_capacity : 0;
+
+    template <size_t capacity, typename = void>
+    struct Buffer
+    {   alignas(alignment < 64 ? alignment : 64) alignas(value_type) value_type values[capacity];
+
+        Buffer() noexcept
+        {
+        }
+    };
+
+    template <typename Enabled>
+    struct Buffer<0, Enabled>
+    {
+    };
+
+    //  Counters for Instrumented, also a base of Data. Const indexing counts too, so they're mutable.
+
+    template <bool enabled, typename = void>
+    struct Counters
+    {   mutable AccessStatistics statistics;
+    };
+
+    template <typename Enabled>
+    struct Counters<false, Enabled>
+    {
+    };
+
+    //  Capacity in elements for Growable, also a base of Data. Only arrays that own their data have it.
+
+    static constexpr bool has_capacity = allocate && growable;
+
+    template <bool enabled, typename = void>
+    struct Capacity
+    {   std::size_t capacity;
+    };
+
+    template <typename Enabled>
+    struct Capacity<false, Enabled>
+    {
+    };
+
+    template <size_t n_dims, typename = void>
+    struct Data : Buffer<buffer_capacity>, Counters<Base_::instrumented>, Capacity<has_capacity>
     {
         value_type *data;
         size_type dims[n_dims];
@@ -91,8 +215,8 @@ private:
         }
     };
 
-    template <>
-    struct Data<0>
+    template <typename Enabled>
+    struct Data<0, Enabled> : Buffer<buffer_capacity>, Counters<Base_::instrumented>, Capacity<has_capacity>
     {   value_type *data;
 
         template <typename ...Dims>
@@ -101,7 +225,45 @@ private:
         }
     };
 
-    Data<order - (efficient_shape ? 1 : 0)> data;
+    Data<stored_dims> data;
+
+    //  Get memory for the data, inline if it fits, and give it back.
+
+    value_type *acquire(std::size_t n)
+    {   if constexpr (buffer_capacity != 0)
+            if (n <= buffer_capacity)
+                return data.values;
+        return allocator_type::allocate(n);
+    }
+
+    bool is_inline() const noexcept
+    {   if constexpr (buffer_capacity != 0)
+            return data.data == data.values;
+        else
+            return false;
+    }
+
+    void free() noexcept
+    {   if (data.data != NULL && !is_inline())
+            allocator_type::deallocate(data.data);
+    }
+
+    //  Leave a moved from or released array without data. A growable one is empty then, so that it can grow again.
+
+    void vacate() noexcept
+    {   data.data = NULL;
+        if constexpr (has_capacity)
+        {   data.capacity = 0;
+            data.dims[stored_index(axis == column ? order - 1 : 0)] = 0;
+        }
+    }
+
+    //  With Growable, the capacity of data that holds n elements. Inline data can grow up to the inline capacity.
+
+    void set_capacity(std::size_t n) noexcept
+    {   if constexpr (has_capacity)
+            data.capacity = is_inline() ? buffer_capacity : n;
+    }
 
 
 
@@ -117,6 +279,12 @@ private:
             static_assert(sizeof...(dims) <= order, "number of given dimensions should be at most order");
         else if constexpr (layout == packed_inc || layout == packed_dec)
             static_assert(sizeof...(dims) <= 1, "packed arrays have equal sides so need only one dimension");
+        else if constexpr (layout == tiled)
+        {   static_assert(sizeof...(dims) <= order, "number of given dimensions should be at most order");
+            static_assert(Base_::tile.size() == order, "tiled arrays need a tile length per dim");
+        }
+        else if constexpr (layout == morton || layout == aosoa)
+            static_assert(sizeof...(dims) <= order, "number of given dimensions should be at most order");
     }
 
     template <typename ...I>
@@ -125,20 +293,78 @@ private:
         static_assert(sizeof...(i) <= order, "must have at most as many indexes as order");
     }
 
+    //  Runtime checks and counting of a full index, for Checked and Instrumented. Dims that EfficientShape doesn't store
+    //  can't be checked.
 
+    template <typename ...I>
+    void check(I... i) const
+    {   if constexpr (checked)
+            Base_::template check_index<true>([this](std::size_t level) -> std::size_t
+                {   if constexpr ((layout == packed_inc || layout == packed_dec) && stored_order == 0)
+                        return dyn;
+                    else if constexpr (layout == packed_inc || layout == packed_dec)
+                        return (*this)[0];
+                    else
+                        return is_fixed(level) || level - dims_offset < stored_order ? (*this)[level] : dyn;
+                }, std::array<std::size_t, order> {static_cast<std::size_t>(i)...});
+    }
 
-private:
+    void record(std::size_t k) const noexcept
+    {   if constexpr (instrumented)
+            data.statistics.record((*this)() + k, sizeof(value_type));
+    }
+
+
+
+public:
+
+    //  Calculate the data size, which depends on Layout and dims. These are the dims as given to the constructor.
+
+    template <typename ...Dims>
+    static std::size_t data_size(Dims... dims) noexcept
+    {   if constexpr (fixed_dims != 0)
+            return std::apply([](auto... dims_){ return layout_size(dims_...); }, all_dims(dims...));
+        else
+            return layout_size(dims...);
+    }
 
-    //  Calculate the data size, which depends on Layout and dims.
+    //  With Extents, the constructor takes either all dims, or only the dynamic ones. These are then all of them, with the
+    //  fixed ones from Extents, and those not given taken 1.
 
     template <typename ...Dims>
-    static std::size_t size(Dims... dims) noexcept
+    static constexpr std::array<size_type, order> all_dims(Dims... dims) noexcept
+    {   const std::array<size_type, sizeof...(dims)> given {static_cast<size_type>(dims)...};
+        std::array<size_type, order> result {};
+        for (std::size_t i = 0, j = 0; i < order; i++)
+            if (is_fixed(i))
+                result[i] = Base_::extents[i];
+            else if (sizeof...(dims) == order)
+                result[i] = given[i];
+            else
+                result[i] = j < sizeof...(dims) ? given[j++] : 1;
+        return result;
+    }
+
+
+
+private:
+
+    template <typename ...Dims>
+    static std::size_t layout_size(Dims... dims) noexcept
     {   if constexpr (sizeof...(dims) == 0)
             return 0;
         else if constexpr (layout == conventional)
             return (dims * ...);
         else if constexpr (layout == packed_inc || layout == packed_dec)
             return Base_::combinations(order + [](auto a, auto... b){ return a; }(dims...) - 1, order);
+        else if constexpr (layout == tiled)
+        {   const std::array<size_type, sizeof...(dims)> dims_ {static_cast<size_type>(dims)...};
+            return Base_::TiledIndexing::size([&](std::size_t level){ return dims_[level]; }, sizeof...(dims));
+        }
+        else if constexpr (layout == morton)
+            return Base_::MortonIndexing::size(std::max({static_cast<std::size_t>(dims)...}), order);
+        else if constexpr (layout == aosoa)
+            return ((dims * ...) + Base_::lanes - 1) / Base_::lanes * Base_::lanes;
     }
 
 
@@ -146,66 +372,338 @@ private:
 private:
 
     //  Calculate 1D memory index based on order-dimensional Array index.
+    //  The indexes are given fastest first, see Base::fastest_first. The level is that of the index in this order.
 
     template <std::size_t level, typename I, typename ...J>
     auto index(I i, J... j) const noexcept
-    {   if constexpr (layout == conventional)
+    {   if constexpr (layout == conventional || layout == aosoa)
         {   if constexpr (sizeof...(j) == 0)
                 return i;
             else
-                return i + index<level + 1>(j...) * (*this)[level];
+                return i + index<level + 1>(j...) * dim<axis == column ? level : order - 1 - level>();
         }
         else if constexpr (layout == packed_inc)
         {   return Base_::PackedIndexing::template C_inc<0>(i, j...);
         }
         else if constexpr (layout == packed_dec)
-        {   return Base_::PackedIndexing::template C_dec<0>((*this)[0], i, j...);
+        {   return Base_::PackedIndexing::C_dec((*this)[0], i, j...);
+        }
+        else if constexpr (layout == tiled)
+        {   return Base_::TiledIndexing::C([this](std::size_t i_){ return (*this)[i_]; }, i, j...);
+        }
+        else if constexpr (layout == morton)
+        {   return Base_::MortonIndexing::C(i, j...);
         }
     }
 
 
 
+private:
+
+    //  First touch of freshly allocated data, in parallel with the static schedule that loops over the data should use too.
+
+    void touch(std::size_t n) noexcept
+    {   value_type *a = data.data;
+        const std::ptrdiff_t n_ = n;
+#if defined(_OPENMP)
+        #pragma omp parallel for schedule(static)
+#endif
+        for (std::ptrdiff_t i = 0; i < n_; i++)
+            a[i] = value_type {};
+    }
+
+
+
+private:
+
+    template <typename ...Dims>
+    void set_dims(Dims... dims) noexcept
+    {   if constexpr (fixed_dims == order)
+        {
+        }
+        else if constexpr (fixed_dims != 0)
+        {   const std::array<size_type, order> dims_ = all_dims(dims...);
+            for (std::size_t i = 0; i < order; i++)
+                if (!is_fixed(i))
+                    data.dims[stored_index(i)] = dims_[i];
+        }
+        else if constexpr (dims_offset == 0 || sizeof...(dims) == 0)
+            data.set_dims(dims...);
+        else
+            [this](auto, auto... dims_){ data.set_dims(dims_...); }(dims...);
+    }
+
+
+
 public:
 
     template <typename ...Dims,
         bool allocate_delayed = allocate, std::enable_if_t<allocate_delayed>* = nullptr>
     Array(Dims... dims)
-        : data {new value_type[size(dims...)]}
+        : data {{}, {}, {}, NULL}
     {   dims_validity(dims...);
-        data.set_dims(dims...);
+        data.data = acquire(data_size(dims...));
+        set_capacity(data_size(dims...));
+        set_dims(dims...);
+        if constexpr (first_touch)
+            touch(data_size(dims...));
     }
 
     template <typename ...Dims,
         bool allocate_delayed = allocate, std::enable_if_t<!allocate_delayed>* = nullptr>
     Array(Dims... dims) noexcept
-        : data {NULL}
+        : data {{}, {}, {}, NULL}
     {   dims_validity(dims...);
-        data.set_dims(dims...);
+        set_dims(dims...);
+    }
+
+
+
+    //  Arrays that own their data can only be moved, copying would share the data. Deep copies are made with copy().
+    //  Arrays that wrap data are copied like a pointer. For the owning ones the copy operations below take an Uncopyable
+    //  instead, which can't be had, so they aren't copy operations, and the implicit ones are deleted by the move
+    //  operations. That way std::is_copy_constructible_v is false for them as well.
+
+    Array(std::conditional_t<allocate, const Uncopyable&, const Array&> A) noexcept
+        : data {A.data}
+    {
+    }
+
+    Array(Array&& A) noexcept
+        : data {A.data}
+    {   if constexpr (buffer_capacity != 0)
+            if (A.is_inline())
+                data.data = data.values;
+        if constexpr (allocate)
+            A.vacate();
+    }
+
+    Array& operator=(std::conditional_t<allocate, const Uncopyable&, const Array&> A) noexcept
+    {   data = A.data;
+        return *this;
+    }
+
+    Array& operator=(Array&& A) noexcept
+    {   if (this != &A)
+        {   if constexpr (allocate)
+                free();
+            data = A.data;
+            if constexpr (buffer_capacity != 0)
+                if (A.is_inline())
+                    data.data = data.values;
+            if constexpr (allocate)
+                A.vacate();
+        }
+        return *this;
     }
 
 
 
     ~Array() noexcept
     {   if constexpr (allocate)
-            delete[] data.data;
+            free();
+    }
+
+
+
+private:
+
+    //  Ownership transfer and copies go through here. The data is taken as is, the dims are copied from A.
+
+    struct Adopt
+    {
+    };
+
+    template <typename A>
+    Array(Adopt, value_type *data_, const A& A_) noexcept
+        : data {{}, {}, {}, data_}
+    {   if constexpr (stored_dims != 0)
+            for (std::size_t i = 0; i < stored_dims; i++)
+                data.dims[i] = A_.data.dims[i];
+        if constexpr (has_capacity)
+            set_capacity(size());
+    }
+
+
+
+public:
+
+    //  Deep copy into an Array that owns its data (also for Arrays that wrap data).
+
+    owner_type copy() const
+    {   static_assert(size_known, "the data size of this array is unknown due to EfficientShape");
+        owner_type A {typename owner_type::Adopt {}, static_cast<value_type *>(NULL), *this};
+        A.data.data = A.acquire(size());
+        A.set_capacity(size());
+        std::copy_n(data.data, size(), A.data.data);
+        return A;
+    }
+
+    //  Hand the data to a wrapper, which doesn't own it. This Array is left empty. The data should be deallocated with
+    //  allocator_type, or handed back with adopt. Inline data is moved to allocated memory first.
+
+    template <bool allocate_delayed = allocate, typename = std::enable_if_t<allocate_delayed>>
+    wrapper_type release() noexcept(buffer_capacity == 0)
+    {   value_type *data_ = data.data;
+        if constexpr (buffer_capacity != 0)
+            if (is_inline())
+            {   static_assert(size_known, "the data size of this array is unknown due to EfficientShape");
+                data_ = allocator_type::allocate(size());
+                std::copy_n(data.data, size(), data_);
+            }
+        wrapper_type A {typename wrapper_type::Adopt {}, data_, *this};
+        vacate();
+        return A;
+    }
+
+    //  Take ownership of the data of a wrapper. That data must come from allocator_type.
+
+    template <bool allocate_delayed = allocate, typename = std::enable_if_t<allocate_delayed>>
+    static Array adopt(const wrapper_type& A) noexcept
+    {   return Array {Adopt {}, A.data.data, A};
+    }
+
+
+
+public:
+
+    //  With Growable, the array grows along the dim of the slowest index, the last for column major and the 1st for row
+    //  major, since its slices come last in memory. The data stays where it is while it fits the capacity, otherwise it's
+    //  moved to memory with at least twice the capacity, so appending is amortized constant time. Dims are in slices.
+    //  New elements aren't initialized.
+
+    template <bool growable_delayed = has_capacity, typename = std::enable_if_t<growable_delayed>>
+    std::size_t capacity() const noexcept
+    {   return data.capacity;
+    }
+
+    template <bool growable_delayed = has_capacity, typename = std::enable_if_t<growable_delayed>>
+    void reserve(std::size_t slices)
+    {   if (slices * slice_size() > data.capacity)
+            reallocate(slices * slice_size());
+    }
+
+    template <bool growable_delayed = has_capacity, typename = std::enable_if_t<growable_delayed>>
+    void resize(std::size_t slices)
+    {   if (slices * slice_size() > data.capacity)
+            reallocate(std::max(slices * slice_size(), 2 * data.capacity));
+        data.dims[stored_index(slowest)] = slices;
+    }
+
+    //  Append a slice, and give its data. Or append a copy of a slice, which may be one of this array.
+
+    template <bool growable_delayed = has_capacity, typename = std::enable_if_t<growable_delayed>>
+    value_type *append_slice()
+    {   const std::size_t slices = (*this)[slowest];
+        resize(slices + 1);
+        return data.data + slices * slice_size();
+    }
+
+    template <bool growable_delayed = has_capacity, typename = std::enable_if_t<growable_delayed>>
+    void append_slice(const value_type *slice)
+    {   const std::less<const value_type *> less;
+        const bool own = !less(slice, data.data) && less(slice, data.data + size());
+        const std::ptrdiff_t offset = slice - (own ? data.data : slice);
+        value_type *end = append_slice();
+        std::copy_n(own ? data.data + offset : slice, slice_size(), end);
+    }
+
+
+
+private:
+
+    static constexpr std::size_t slowest = axis == column ? order - 1 : 0;
+
+    //  Elements per slice along the slowest dim.
+
+    std::size_t slice_size() const noexcept
+    {   std::size_t result = 1;
+        for (std::size_t i = 0; i < order; i++)
+            if (i != slowest)
+                result *= (*this)[i];
+        return result;
+    }
+
+    void reallocate(std::size_t capacity)
+    {   value_type *data_ = allocator_type::allocate(capacity);
+        std::copy_n(data.data, size(), data_);
+        free();
+        data.data = data_;
+        data.capacity = capacity;
     }
 
 
 
 public:
 
-    //  Dimension operator.
+    //  Dimension operator. Dims can be changed through it, except with Extents, then it gives them by value.
 
     template <typename I>
-    size_type& operator[](I i) noexcept
+    decltype(auto) operator[](I i) noexcept
     {   index_validity(i);
-        return data.dims[i];
+        if constexpr (fixed_dims == order)
+            return static_cast<size_type>(Base_::extents[i]);
+        else if constexpr (fixed_dims != 0)
+            return static_cast<size_type>(is_fixed(i) ? Base_::extents[i] : data.dims[stored_index(i)]);
+        else
+            return data.dims[i - dims_offset];
     }
 
     template <typename I>
-    const size_type& operator[](I i) const noexcept
+    decltype(auto) operator[](I i) const noexcept
     {   index_validity(i);
-        return data.dims[i];
+        if constexpr (fixed_dims == order)
+            return static_cast<size_type>(Base_::extents[i]);
+        else if constexpr (fixed_dims != 0)
+            return static_cast<size_type>(is_fixed(i) ? Base_::extents[i] : data.dims[stored_index(i)]);
+        else
+            return data.dims[i - dims_offset];
+    }
+
+
+
+private:
+
+    //  Dim with a compile time level, a constant if it's fixed.
+
+    template <std::size_t i>
+    size_type dim() const noexcept
+    {   if constexpr (is_fixed(i))
+            return Base_::extents[i];
+        else
+            return (*this)[i];
+    }
+
+
+
+public:
+
+    //  Data size, i.e. the number of elements in memory.
+
+    std::size_t size() const noexcept
+    {   static_assert(size_known, "the data size of this array is unknown due to EfficientShape");
+        if constexpr (layout == conventional)
+        {   std::size_t result = 1;
+            for (std::size_t i = 0; i < order; i++)
+                result *= (*this)[i];
+            return result;
+        }
+        else if constexpr (layout == packed_inc || layout == packed_dec)
+            return data_size((*this)[0]);
+        else if constexpr (layout == tiled)
+            return Base_::TiledIndexing::size([this](std::size_t level){ return (*this)[level]; }, order);
+        else if constexpr (layout == morton)
+        {   std::size_t dim = 0;
+            for (std::size_t i = 0; i < order; i++)
+                dim = std::max<std::size_t>(dim, (*this)[i]);
+            return Base_::MortonIndexing::size(dim, order);
+        }
+        else if constexpr (layout == aosoa)
+        {   std::size_t result = 1;
+            for (std::size_t i = 0; i < order; i++)
+                result *= (*this)[i];
+            return (result + Base_::lanes - 1) / Base_::lanes * Base_::lanes;
+        }
     }
 
 
@@ -241,22 +739,146 @@ public:
 
     //  Indexing.
 
+    //  Missing indexes are those that run fastest, and are taken 0. With Checked, the full index is checked, so a partial
+    //  index of packed_dec that isn't in the triangle throws.
+    //  For the aosoa layout this gives a reference to the members of the element (see Base::AoSoAIndexing), not a
+    //  value_type&.
+
     template <typename ...I>
-    value_type& operator()(I... i) noexcept
+    decltype(auto) operator()(I... i) noexcept(!checked)
     {   index_validity(i...);
-        if constexpr (sizeof...(i) != order)
+        if constexpr (sizeof...(i) != order && axis == column)
             return (*this)(0, i...);
+        else if constexpr (sizeof...(i) != order && axis == row)
+            return (*this)(i..., 0);
         else
-            return (*this)()[index<0>(i...)];
+        {   check(i...);
+            const std::size_t k = Base_::fastest_first([this](auto... i_){ return index<0>(i_...); }, i...);
+            record(k);
+            if constexpr (layout == aosoa)
+                return Base_::AoSoAIndexing::at((*this)(), k);
+            else
+                return (*this)()[k];
+        }
     }
 
     template <typename ...I>
-    const value_type& operator()(I... i) const noexcept
+    decltype(auto) operator()(I... i) const noexcept(!checked)
     {   index_validity(i...);
-        if constexpr (sizeof...(i) != order)
+        if constexpr (sizeof...(i) != order && axis == column)
             return (*this)(0, i...);
+        else if constexpr (sizeof...(i) != order && axis == row)
+            return (*this)(i..., 0);
         else
-            return (*this)()[index<0>(i...)];
+        {   check(i...);
+            const std::size_t k = Base_::fastest_first([this](auto... i_){ return index<0>(i_...); }, i...);
+            record(k);
+            if constexpr (layout == aosoa)
+                return Base_::AoSoAIndexing::at((*this)(), k);
+            else
+                return (*this)()[k];
+        }
+    }
+
+
+
+public:
+
+    //  Access statistics with Instrumented, see AccessStatistics. They can be reset through this reference.
+
+    template <bool instrumented_delayed = instrumented, typename = std::enable_if_t<instrumented_delayed>>
+    AccessStatistics& statistics() const noexcept
+    {   return data.statistics;
+    }
+
+
+
+public:
+
+    //  View of part of this Array, with an argument per dim (see View::Range). Nothing is copied or allocated.
+
+    template <typename ...Args>
+    auto view(Args... args)
+    {   view_validity<Args...>();
+        const auto dims = known_dims();
+        return View::make<axis>((*this)(), dims.data(), Base_::strides(dims).data(), args...);
+    }
+
+    template <typename ...Args>
+    auto view(Args... args) const
+    {   view_validity<Args...>();
+        const auto dims = known_dims();
+        return View::make<axis>((*this)(), dims.data(), Base_::strides(dims).data(), args...);
+    }
+
+
+
+private:
+
+    //  With EfficientShape the dim of the slowest index is unknown, so the whole of it can't be viewed.
+
+    template <typename ...Args>
+    static constexpr void view_validity() noexcept
+    {   static_assert(layout == conventional, "views only exist for the conventional layout");
+        static_assert(sizeof...(Args) == order, "views take one argument per dim");
+        static_assert(!efficient_shape
+            || !std::is_same_v<std::tuple_element_t<axis == column ? order - 1 : 0, std::tuple<Args...>>, View::All>,
+            "the dim of the slowest index is unknown due to EfficientShape");
+    }
+
+    //  All dims, where the one EfficientShape doesn't store is taken 0.
+
+    std::array<size_type, order> known_dims() const noexcept
+    {   std::array<size_type, order> dims {};
+        for (std::size_t i = 0; i < order; i++)
+            if (i - dims_offset < stored_order)
+                dims[i] = (*this)[i];
+        return dims;
+    }
+
+
+
+public:
+
+    //  Iteration over the data in memory order, which for the conventional layout is every element, fastest index first.
+    //  This is a pointer walk.
+
+    value_type *begin() noexcept
+    {   return (*this)();
+    }
+
+    const value_type *begin() const noexcept
+    {   return (*this)();
+    }
+
+    value_type *end() noexcept
+    {   return (*this)() + size();
+    }
+
+    const value_type *end() const noexcept
+    {   return (*this)() + size();
+    }
+
+    //  Iteration in memory order that also keeps track of the indexes, see IndexIterator.
+
+    auto indexed() noexcept
+    {   using Iterator = IndexIterator<Array, value_type>;
+        return IndexRange<Iterator> {Iterator {begin(), known_dims()}, Iterator {end(), known_dims()}};
+    }
+
+    auto indexed() const noexcept
+    {   using Iterator = IndexIterator<Array, const value_type>;
+        return IndexRange<Iterator> {Iterator {begin(), known_dims()}, Iterator {end(), known_dims()}};
+    }
+
+    //  Cursor for loops that step one index at a time, see Cursor.
+
+    auto cursor() noexcept
+    {   return Cursor<Array, value_type> {(*this)(), known_dims()};
+    }
+
+    auto cursor() const noexcept
+    {   return Cursor<Array, const value_type> {(*this)(), known_dims()};
     }
 };
 
@@ -0,0 +1,333 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Type.h"
+
+namespace Irulan
+{   namespace Expression
+    {
+
+//  Lazy element-wise expressions over arrays (Static, Dynamic and View) and scalars, e.g. assign(C, A + B * s). Operators
+//  build a tree that holds the arrays by reference, and assign evaluates it in one loop, without temporaries:
+//      A + B, A - B, A * B, A / B, -A      element-wise, for arrays, expressions and scalars
+//      map(f, A, B...)                      element-wise f(a, b...)
+//      assign(C, e)                         sets every element of C to that of e, the dims must match
+//  When all arrays have the same layout, axis and dims as C (and are stored whole, not views), the loop runs over memory
+//  as a pointer walk, marked for vectorization (omp simd) unless it calls functions given to map. Otherwise it runs over the indexes of C in its memory order, and indexes every
+//  array. The arrays may include C itself, since each element is only read at the index it's written to.
+//  Packed arrays are only read in their triangle, so they can only be assigned to C of the same layout and axis.
+//  The operators only exist with this header included, and only for Irulan types.
+
+
+
+//  Traits of the leaves: arrays are indexed, anything else that isn't an expression is a scalar.
+
+template <typename A, typename = void>
+struct IsArray : std::false_type
+{
+};
+
+template <typename A>
+struct IsArray<A, std::void_t<decltype(A::layout), decltype(A::axis), decltype(A::order), typename A::value_type,
+    decltype(std::declval<const A&>()())>>
+    : std::true_type
+{
+};
+
+template <typename A, typename = void>
+struct IsWhole : std::false_type
+{
+};
+
+template <typename A>
+struct IsWhole<A, std::void_t<decltype(std::declval<const A&>().size())>> : std::true_type
+{
+};
+
+template <typename A, typename = void>
+struct IsEfficient : std::false_type
+{
+};
+
+template <typename A>
+struct IsEfficient<A, std::enable_if_t<A::efficient_shape>> : std::true_type
+{
+};
+
+struct NodeBase
+{
+};
+
+template <typename E>
+constexpr bool is_node = std::is_base_of_v<NodeBase, E>;
+
+template <typename E>
+constexpr bool is_operand = is_node<E> || IsArray<E>::value;
+
+//  Dim of an array at some level, or dyn if EfficientShape doesn't store it. Packed arrays store a single dim.
+
+template <typename A>
+std::size_t dim(const A& a, std::size_t level) noexcept
+{   if constexpr (A::layout == packed_inc || A::layout == packed_dec)
+        return a[0];
+    else if constexpr (IsEfficient<A>::value)
+        return level == (A::axis == column ? A::order - 1 : 0) ? dyn : a[level];
+    else
+        return a[level];
+}
+
+
+
+//  Leaf for an array, held by reference. Views are held by value, like pointers, since they're often temporaries.
+
+template <typename A>
+struct Terminal : NodeBase
+{   static_assert(A::layout != aosoa, "elements of the aosoa layout aren't stored as a whole");
+
+    static constexpr bool builtin = true;
+
+    std::conditional_t<IsWhole<A>::value, const A&, A> a;
+
+    template <typename C>
+    bool matches(const C& c) const noexcept
+    {   static_assert(A::order == C::order, "the arrays of an expression must have the same order");
+        static_assert((A::layout != packed_inc && A::layout != packed_dec) || (A::layout == C::layout && A::axis == C::axis),
+            "packed arrays in an expression are only valid in their triangle, C must have the same layout and axis");
+        for (std::size_t level = 0; level < C::order; level++)
+            if (dim(a, level) != dyn && dim(a, level) != dim(c, level))
+                return false;
+        return true;
+    }
+
+    //  Whether a has the same data layout as c, given that the dims match.
+
+    template <typename C>
+    bool flat(const C&) const noexcept
+    {   return IsWhole<A>::value && IsWhole<C>::value && A::layout == C::layout && A::axis == C::axis &&
+            A::layout != tiled && !IsEfficient<A>::value;
+    }
+
+    template <typename ...I>
+    decltype(auto) at(I... i) const
+    {   return a(i...);
+    }
+
+    decltype(auto) at_memory(std::size_t k) const noexcept
+    {   return a()[k];
+    }
+};
+
+//  Leaf for a scalar, held by value.
+
+template <typename T>
+struct Scalar : NodeBase
+{   static constexpr bool builtin = true;
+
+    T value;
+
+    template <typename C>
+    bool matches(const C&) const noexcept
+    {   return true;
+    }
+
+    template <typename C>
+    bool flat(const C&) const noexcept
+    {   return true;
+    }
+
+    template <typename ...I>
+    const T& at(I...) const noexcept
+    {   return value;
+    }
+
+    const T& at_memory(std::size_t) const noexcept
+    {   return value;
+    }
+};
+
+//  Wrap an operand as a node: expressions as they are, arrays by reference, the rest as scalars.
+
+template <typename E>
+auto node(const E& e) noexcept
+{   if constexpr (is_node<E>)
+        return e;
+    else if constexpr (IsArray<E>::value)
+        return Terminal<E> {{}, e};
+    else
+        return Scalar<E> {{}, e};
+}
+
+template <typename E>
+using Node = decltype(node(std::declval<const E&>()));
+
+//  Whether f is one of the operators, which have no side effects. Only trees of those are evaluated in SIMD loops, as
+//  the calls of a user's f may depend on each other.
+
+template <typename F>
+constexpr bool is_builtin = std::is_same_v<F, std::plus<>> || std::is_same_v<F, std::minus<>> ||
+    std::is_same_v<F, std::multiplies<>> || std::is_same_v<F, std::divides<>> || std::is_same_v<F, std::negate<>>;
+
+//  Inner node, f of its operands.
+
+template <typename F, typename ...E>
+struct Map : NodeBase
+{   static constexpr bool builtin = is_builtin<F> && (E::builtin && ...);
+
+    F f;
+    std::tuple<E...> operands;
+
+    template <typename C>
+    bool matches(const C& c) const noexcept
+    {   return std::apply([&](const auto&... e){ return (e.matches(c) && ...); }, operands);
+    }
+
+    template <typename C>
+    bool flat(const C& c) const noexcept
+    {   return std::apply([&](const auto&... e){ return (e.flat(c) && ...); }, operands);
+    }
+
+    template <typename ...I>
+    decltype(auto) at(I... i) const
+    {   return std::apply([&](const auto&... e){ return f(e.at(i...)...); }, operands);
+    }
+
+    decltype(auto) at_memory(std::size_t k) const
+    {   return std::apply([&](const auto&... e){ return f(e.at_memory(k)...); }, operands);
+    }
+};
+
+
+
+//  Element-wise f of some operands, of which at least one should be an array or expression.
+
+template <typename F, typename ...E>
+auto map(F f, const E&... e)
+{   static_assert((is_operand<E> || ...), "map needs an array or expression");
+    return Map<F, Node<E>...> {{}, f, {node(e)...}};
+}
+
+template <typename A, typename B, typename = std::enable_if_t<is_operand<A> || is_operand<B>>>
+auto operator+(const A& a, const B& b)
+{   return map(std::plus<> {}, a, b);
+}
+
+template <typename A, typename B, typename = std::enable_if_t<is_operand<A> || is_operand<B>>>
+auto operator-(const A& a, const B& b)
+{   return map(std::minus<> {}, a, b);
+}
+
+template <typename A, typename B, typename = std::enable_if_t<is_operand<A> || is_operand<B>>>
+auto operator*(const A& a, const B& b)
+{   return map(std::multiplies<> {}, a, b);
+}
+
+template <typename A, typename B, typename = std::enable_if_t<is_operand<A> || is_operand<B>>>
+auto operator/(const A& a, const B& b)
+{   return map(std::divides<> {}, a, b);
+}
+
+template <typename A, typename = std::enable_if_t<is_operand<A>>>
+auto operator-(const A& a)
+{   return map(std::negate<> {}, a);
+}
+
+
+
+//  Loop over the indexes of C in its memory order, from the slowest position down. For packed layouts the range of a
+//  position depends on the index at the position outside it.
+
+template <std::size_t position, typename C, typename E, typename Index>
+void assign_indexed(C& c, const E& e, Index& index, const Index& dims)
+{   constexpr std::size_t order = C::order;
+    constexpr std::size_t level = C::axis == column ? position : order - 1 - position;
+    constexpr std::size_t outer = C::axis == column ? position + 1 : order - 2 - position;
+    std::size_t begin = 0, end = dims[level];
+    if constexpr (position + 1 < order && C::layout == packed_inc)
+        end = index[outer] + 1;
+    if constexpr (position + 1 < order && C::layout == packed_dec)
+        begin = index[outer];
+    for (index[level] = begin; index[level] < end; index[level]++)
+        if constexpr (position == 0)
+            std::apply([&](auto... i){ c(i...) = e.at(i...); }, index);
+        else
+            assign_indexed<position - 1>(c, e, index, dims);
+}
+
+//  Evaluate an expression into C, which is an array of the same dims. Throws std::invalid_argument if the dims differ.
+
+template <typename C, typename E>
+void assign(C& c, const E& e)
+{   static_assert(IsArray<C>::value, "expressions are assigned to arrays");
+    static_assert(!IsEfficient<C>::value, "the dims of the array must be known");
+    static_assert(C::layout != aosoa, "elements of the aosoa layout aren't stored as a whole");
+    const auto n = node(e);
+    if (!n.matches(c))
+        throw std::invalid_argument {"the arrays of an expression must have the same dims"};
+    if constexpr (IsWhole<C>::value && C::layout != tiled)
+        if (n.flat(c))
+        {   auto *data = c();
+            const std::size_t size = c.size();
+            if constexpr (decltype(n)::builtin)
+            {
+#if defined(_OPENMP)
+                #pragma omp simd
+#endif
+                for (std::size_t k = 0; k < size; k++)
+                    data[k] = n.at_memory(k);
+            }
+            else
+                for (std::size_t k = 0; k < size; k++)
+                    data[k] = n.at_memory(k);
+            return;
+        }
+    std::array<std::size_t, C::order> index {}, dims;
+    for (std::size_t level = 0; level < C::order; level++)
+        dims[level] = dim(c, level);
+    assign_indexed<C::order - 1>(c, n, index, dims);
+}
+
+    }
+
+//  The operators are found for the arrays through their namespaces.
+
+namespace Static
+{   using Expression::operator+, Expression::operator-, Expression::operator*, Expression::operator/;
+}
+
+namespace Dynamic
+{   using Expression::operator+, Expression::operator-, Expression::operator*, Expression::operator/;
+}
+
+namespace View
+{   using Expression::operator+, Expression::operator-, Expression::operator*, Expression::operator/;
+}
+
+}
@@ -0,0 +1,363 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Type.h"
+
+namespace Irulan
+{   namespace File
+    {
+
+//  Irulan files hold a single Dynamic::Array. They start with a header describing the Array type and dims, and the data
+//  follows at an offset that's a multiple of the page size, so that it can be mapped (see Mapping.h) or read in one go.
+//  The data is the memory of the Array as is, nothing needs to be parsed. Everything is in the byte order of the machine.
+//      magic           8 bytes, "IRULAN" and 2 zero bytes
+//      version         uint32
+//      order           uint32
+//      layout          uint32, LayoutEnum
+//      axis            uint32, AxisEnum
+//      value kind      uint32, Kind
+//      size type size  uint32, i.e. sizeof(size_type)
+//      value size      uint64, i.e. sizeof(value_type)
+//      data offset     uint64
+//      dims            uint64 per dim
+//      tile            uint64 per dim, the tile shape for the tiled layout, the lanes and zeros for aosoa, otherwise 0
+
+constexpr char magic[8] {'I', 'R', 'U', 'L', 'A', 'N', '\0', '\0'};
+constexpr std::uint32_t version = 1;
+constexpr std::uint64_t data_alignment = 4096;
+
+//  Kind of value type. Together with the value size this identifies arithmetic types. Other types (structs, complex
+//  numbers, ...) only have their size checked.
+
+enum Kind : std::uint32_t {other, signed_integer, unsigned_integer, floating_point};
+
+template <typename T>
+constexpr Kind kind() noexcept
+{   if constexpr (std::is_floating_point_v<T>)
+        return floating_point;
+    else if constexpr (std::is_integral_v<T>)
+        return std::is_signed_v<T> ? signed_integer : unsigned_integer;
+    else
+        return other;
+}
+
+struct Header
+{   std::uint32_t order;
+    std::uint32_t layout;
+    std::uint32_t axis;
+    std::uint32_t value_kind;
+    std::uint32_t size_type_size;
+    std::uint64_t value_size;
+    std::uint64_t data_offset;
+    std::vector<std::uint64_t> dims;
+    std::vector<std::uint64_t> tile;
+};
+
+
+
+//  Size of the header in the file.
+
+inline std::size_t header_size(std::uint32_t order) noexcept
+{   return sizeof magic + 6 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t) + 2 * order * sizeof(std::uint64_t);
+}
+
+inline void write_header(char *p, const Header& header) noexcept
+{   auto put = [&p](const void *a, std::size_t n)
+        {   std::memcpy(p, a, n);
+            p += n;
+        };
+    put(magic, sizeof magic);
+    put(&version, sizeof version);
+    put(&header.order, sizeof header.order);
+    put(&header.layout, sizeof header.layout);
+    put(&header.axis, sizeof header.axis);
+    put(&header.value_kind, sizeof header.value_kind);
+    put(&header.size_type_size, sizeof header.size_type_size);
+    put(&header.value_size, sizeof header.value_size);
+    put(&header.data_offset, sizeof header.data_offset);
+    put(header.dims.data(), header.order * sizeof(std::uint64_t));
+    put(header.tile.data(), header.order * sizeof(std::uint64_t));
+}
+
+//  Reads the header from the 1st size bytes of a file. Throws std::runtime_error if this is no valid header.
+
+inline Header read_header(const char *p, std::size_t size)
+{   const char *end = p + size;
+    auto get = [&p, end](void *a, std::size_t n)
+        {   if (static_cast<std::size_t>(end - p) < n)
+                throw std::runtime_error {"Irulan file header is truncated"};
+            std::memcpy(a, p, n);
+            p += n;
+        };
+    char magic_[sizeof magic];
+    std::uint32_t version_;
+    Header header;
+    get(magic_, sizeof magic_);
+    if (std::memcmp(magic_, magic, sizeof magic) != 0)
+        throw std::runtime_error {"not an Irulan file"};
+    get(&version_, sizeof version_);
+    if (version_ != version)
+        throw std::runtime_error {"unsupported Irulan file version"};
+    get(&header.order, sizeof header.order);
+    get(&header.layout, sizeof header.layout);
+    get(&header.axis, sizeof header.axis);
+    get(&header.value_kind, sizeof header.value_kind);
+    get(&header.size_type_size, sizeof header.size_type_size);
+    get(&header.value_size, sizeof header.value_size);
+    get(&header.data_offset, sizeof header.data_offset);
+    if (static_cast<std::size_t>(end - p) / (2 * sizeof(std::uint64_t)) < header.order)
+        throw std::runtime_error {"Irulan file header is truncated"};
+    header.dims.resize(header.order);
+    get(header.dims.data(), header.order * sizeof(std::uint64_t));
+    header.tile.resize(header.order);
+    get(header.tile.data(), header.order * sizeof(std::uint64_t));
+    return header;
+}
+
+
+
+//  Header for an Array type with the dims given to its constructor (so e.g. one dim for packed Arrays). All dims are
+//  stored, those not given are taken equal to the 1st (packed), or as the constructor does (others, see all_dims).
+
+template <typename Array, typename ...Dims>
+Header make_header(Dims... dims)
+{   static_assert(sizeof...(dims) != 0, "arrays in files must have dims");
+    Header header {Array::order, Array::layout, Array::axis, kind<typename Array::value_type>(),
+        sizeof(typename Array::size_type), sizeof(typename Array::value_type), 0, {static_cast<std::uint64_t>(dims)...},
+        std::vector<std::uint64_t>(Array::order)};
+    if constexpr (Array::layout == packed_inc || Array::layout == packed_dec)
+        header.dims.resize(Array::order, header.dims[0]);
+    else
+    {   const auto all_dims = Array::all_dims(dims...);
+        header.dims.assign(all_dims.begin(), all_dims.end());
+    }
+    if constexpr (Array::layout == tiled)
+        for (std::size_t i = 0; i < Array::order; i++)
+            header.tile[i] = Array::tile[i];
+    if constexpr (Array::layout == aosoa)
+        header.tile[0] = Array::lanes;
+    header.data_offset = (header_size(header.order) + data_alignment - 1) / data_alignment * data_alignment;
+    return header;
+}
+
+//  Checks that a header belongs to an Array type. Throws std::runtime_error if it doesn't. Properties that don't change the
+//  data, like EfficientShape or Alignment, can differ. So can the size type, as long as the dims fit. Dims fixed by
+//  Extents must be those in the file. The data size must fit a std::size_t, so data_bytes can't wrap around.
+
+template <typename Array>
+void check_header(const Header& header)
+{   using size_type = typename Array::size_type;
+    if (header.order != Array::order)
+        throw std::runtime_error {"Irulan file has a different order"};
+    if (header.layout != Array::layout)
+        throw std::runtime_error {"Irulan file has a different layout"};
+    if (header.axis != Array::axis)
+        throw std::runtime_error {"Irulan file has a different axis"};
+    if (header.value_kind != kind<typename Array::value_type>() || header.value_size != sizeof(typename Array::value_type))
+        throw std::runtime_error {"Irulan file has a different value type"};
+    for (std::size_t i = 0; i < Array::order; i++)
+    {   if (header.dims[i] > static_cast<std::uint64_t>(std::numeric_limits<size_type>::max()))
+            throw std::runtime_error {"Irulan file has dims that don't fit the size type"};
+        if constexpr (Array::extents.size() != 0)
+            if (Array::extents[i] != dyn && header.dims[i] != Array::extents[i])
+                throw std::runtime_error {"Irulan file has dims other than the fixed extents"};
+        std::uint64_t tile = 0;
+        if constexpr (Array::layout == tiled)
+            tile = Array::tile[i];
+        if constexpr (Array::layout == aosoa)
+            tile = i == 0 ? Array::lanes : 0;
+        if (header.tile[i] != tile)
+            throw std::runtime_error {"Irulan file has a different tile shape"};
+    }
+    if (header.data_offset % data_alignment != 0 || header.data_offset < header_size(header.order))
+        throw std::runtime_error {"Irulan file has an invalid data offset"};
+    //  The data size in bytes must fit, bounded by the dims as they're padded (to whole tiles, lanes, or the morton cube).
+    //  Packed layouts store less than that, so this bound holds for them too.
+    constexpr std::uint64_t max = std::numeric_limits<std::size_t>::max();
+    std::uint64_t side = 1;
+    if constexpr (Array::layout == morton)
+        for (std::size_t i = 0; i < Array::order; i++)
+            while (side < header.dims[i])
+            {   if (side > max / 2)
+                    throw std::runtime_error {"Irulan file has a data size that doesn't fit in memory"};
+                side *= 2;
+            }
+    std::uint64_t bytes = header.value_size;
+    for (std::size_t i = 0; i < Array::order; i++)
+    {   std::uint64_t n = header.dims[i];
+        if (Array::layout == morton)
+            n = side;
+        else if (header.tile[i] != 0)
+            n = n / header.tile[i] * header.tile[i] + (n % header.tile[i] != 0 ? header.tile[i] : 0);
+        if (n < header.dims[i] || (n != 0 && bytes > max / n))
+            throw std::runtime_error {"Irulan file has a data size that doesn't fit in memory"};
+        bytes *= n;
+    }
+}
+
+//  Calls f with the dims of a header as they'd be given to the constructor of an Array type.
+
+template <typename Array, typename F, std::size_t ...i>
+auto apply_dims(const Header& header, F f, std::index_sequence<i...>)
+{   return f(static_cast<typename Array::size_type>(header.dims[i])...);
+}
+
+template <typename Array, typename F>
+auto apply_dims(const Header& header, F f)
+{   constexpr std::size_t n = Array::layout == packed_inc || Array::layout == packed_dec ? 1 : Array::order;
+    return apply_dims<Array>(header, f, std::make_index_sequence<n> {});
+}
+
+//  Data size of an Array type with the dims in a header, in bytes.
+
+template <typename Array>
+std::size_t data_bytes(const Header& header)
+{   return apply_dims<Array>(header, [](auto... dims){ return Array::data_size(dims...); })
+        * sizeof(typename Array::value_type);
+}
+
+
+
+//  Writes an Irulan file in chunks, so the data never has to be in memory as a whole. The chunks are written in memory
+//  order of the Array type, i.e. as if they were copied to its data one after the other. Throws std::runtime_error on
+//  failure, or when writing more or less than the data size.
+
+template <typename Array>
+struct Writer
+{
+
+private:
+
+    using value_type = typename Array::value_type;
+
+    std::ofstream file;
+    std::size_t remaining;
+
+
+
+public:
+
+    template <typename ...Dims>
+    Writer(const std::string& path, Dims... dims)
+        : file {path, std::ios::binary | std::ios::trunc}
+    {   if (!file)
+            throw std::runtime_error {"can't create " + path};
+        const Header header = make_header<Array>(dims...);
+        std::vector<char> bytes(header.data_offset);
+        write_header(bytes.data(), header);
+        file.write(bytes.data(), bytes.size());
+        remaining = data_bytes<Array>(header) / sizeof(value_type);
+    }
+
+    //  Append n values.
+
+    void write(const value_type *p, std::size_t n)
+    {   if (n > remaining)
+            throw std::runtime_error {"writing more than the data size"};
+        file.write(reinterpret_cast<const char *>(p), n * sizeof(value_type));
+        if (!file)
+            throw std::runtime_error {"writing failed"};
+        remaining -= n;
+    }
+
+    //  Finish the file. Without this the destructor closes it too, but doesn't report failures.
+
+    void close()
+    {   if (remaining != 0)
+            throw std::runtime_error {"writing less than the data size"};
+        file.close();
+        if (!file)
+            throw std::runtime_error {"writing failed"};
+    }
+};
+
+
+
+//  Calls f with the dims of an Array as they were given to its constructor.
+
+template <typename Array, typename F, std::size_t ...i>
+auto array_dims(const Array& A, F f, std::index_sequence<i...>)
+{   return f(A[i]...);
+}
+
+template <typename Array, typename F>
+auto array_dims(const Array& A, F f)
+{   constexpr bool packed = Array::layout == packed_inc || Array::layout == packed_dec;
+    static_assert(!Array::efficient_shape || (packed && Array::order > 1), "the dims of the array must be known");
+    return array_dims(A, f, std::make_index_sequence<packed ? 1 : Array::order> {});
+}
+
+//  Save a whole Array.
+
+template <typename Array>
+void save(const std::string& path, const Array& A)
+{   Writer<Array> W = array_dims(A, [&path](auto... dims){ return Writer<Array> {path, dims...}; });
+    W.write(A(), A.size());
+    W.close();
+}
+
+//  Load an Array. Its data is read straight from the file, for large files a Mapping avoids even that.
+
+template <typename Array>
+typename Array::owner_type load(const std::string& path)
+{   using Owner = typename Array::owner_type;
+    std::ifstream file {path, std::ios::binary};
+    if (!file)
+        throw std::runtime_error {"can't open " + path};
+    std::vector<char> bytes(header_size(0));
+    file.read(bytes.data(), bytes.size());
+    std::size_t size = file.gcount();
+    if (size == bytes.size() && std::memcmp(bytes.data(), magic, sizeof magic) == 0)
+    {   std::uint32_t order;
+        std::memcpy(&order, bytes.data() + sizeof magic + sizeof version, sizeof order);
+        if (order != Owner::order)
+            throw std::runtime_error {"Irulan file has a different order"};
+        bytes.resize(header_size(order));
+        file.read(bytes.data() + size, bytes.size() - size);
+        size += file.gcount();
+    }
+    const Header header = read_header(bytes.data(), size);
+    file.clear();
+    check_header<Owner>(header);
+    Owner A = apply_dims<Owner>(header, [](auto... dims){ return Owner {dims...}; });
+    file.seekg(header.data_offset);
+    file.read(reinterpret_cast<char *>(A()), data_bytes<Owner>(header));
+    if (!file)
+        throw std::runtime_error {"Irulan file is truncated"};
+    return A;
+}
+
+    }
+}
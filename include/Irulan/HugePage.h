@@ -0,0 +1,179 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "Memory.h"
+
+namespace Irulan
+{
+
+//  The pages backing some memory. Transparent means the kernel was asked to back it with huge pages of that size
+//  (transparent huge pages), which it does when it can, possibly later.
+
+struct Pages
+{   std::size_t size;
+    bool transparent;
+};
+
+//  Memory for large buffers on huge pages, with mmap, to cut TLB misses. In order of preference:
+//      1 GiB pages from hugetlbfs, for buffers of at least 1 GiB
+//      2 MiB pages from hugetlbfs
+//      normal pages aligned to 2 MiB, with madvise(MADV_HUGEPAGE) for transparent huge pages
+//      normal pages
+//  Buffers smaller than 2 MiB go on normal pages. The hugetlbfs pages must be reserved by the system (vm.nr_hugepages),
+//  so they're often not available, and then the next option is tried. Which one it became is given by pages.
+//  Allocations are kept in a table, so deallocation needs only the pointer.
+
+struct HugePages
+{
+
+private:
+
+    static constexpr std::size_t huge = std::size_t {1} << 21;
+    static constexpr std::size_t gigantic = std::size_t {1} << 30;
+
+    struct Allocation
+    {   void *base;
+        std::size_t length;
+        Pages pages;
+    };
+
+    static std::mutex& mutex() noexcept
+    {   static std::mutex m;
+        return m;
+    }
+
+    static std::unordered_map<const void *, Allocation>& table() noexcept
+    {   static std::unordered_map<const void *, Allocation> t;
+        return t;
+    }
+
+    static std::size_t round_up(std::size_t n, std::size_t m) noexcept
+    {   return (n + m - 1) / m * m;
+    }
+
+    static void *map(std::size_t length, int flags) noexcept
+    {   void *p = ::mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+        return p == MAP_FAILED ? NULL : p;
+    }
+
+    static Allocation map(std::size_t bytes, std::size_t alignment) noexcept
+    {   const std::size_t page = ::sysconf(_SC_PAGESIZE);
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+        for (const std::size_t size : {gigantic, huge})
+            if (bytes >= size && alignment <= size)
+            {   const int log2 = size == gigantic ? 30 : 21;
+                const std::size_t length = round_up(bytes, size);
+                if (void *p = map(length, MAP_HUGETLB | (log2 << MAP_HUGE_SHIFT)))
+                    return {p, length, {size, false}};
+            }
+#endif
+        //  Normal pages, with room to align the data to 2 MiB for transparent huge pages, or to the alignment.
+        const bool transparent = bytes >= huge;
+        const std::size_t align = std::max(transparent ? huge : page, alignment);
+        const std::size_t length = round_up(bytes, page) + (align > page ? align : 0);
+        void *p = map(length, 0);
+        if (p == NULL)
+            return {NULL, 0, {0, false}};
+        Pages pages {page, false};
+#if defined(MADV_HUGEPAGE)
+        if (transparent)
+        {   char *data = reinterpret_cast<char *>(round_up(reinterpret_cast<std::uintptr_t>(p), align));
+            //  Only up to the end of the mapping, what's mapped after it isn't ours to advise.
+            const std::size_t end = static_cast<char *>(p) + length - data;
+            const std::size_t advised = std::min(round_up(bytes, huge), end);
+            if (::madvise(data, advised, MADV_HUGEPAGE) == 0)
+                pages = {huge, true};
+        }
+#endif
+        return {p, length, pages};
+    }
+
+
+
+public:
+
+    static void *allocate(std::size_t bytes, std::size_t alignment)
+    {   const Allocation a = map(bytes != 0 ? bytes : 1, alignment);
+        if (a.base == NULL)
+            throw std::bad_alloc {};
+        const std::size_t align = std::max(a.pages.size, alignment);
+        void *data = reinterpret_cast<void *>(round_up(reinterpret_cast<std::uintptr_t>(a.base), align));
+        const std::lock_guard<std::mutex> lock {mutex()};
+        table().emplace(data, a);
+        return data;
+    }
+
+    static void deallocate(void *data) noexcept
+    {   if (data == NULL)
+            return;
+        Allocation a;
+        {   const std::lock_guard<std::mutex> lock {mutex()};
+            const auto i = table().find(data);
+            if (i == table().end())
+                return;
+            a = i->second;
+            table().erase(i);
+        }
+        ::munmap(a.base, a.length);
+    }
+
+    //  The pages that memory from allocate is on, or size 0 for other memory.
+
+    static Pages pages(const void *data) noexcept
+    {   const std::lock_guard<std::mutex> lock {mutex()};
+        const auto i = table().find(data);
+        return i != table().end() ? i->second.pages : Pages {0, false};
+    }
+};
+
+//  Allocator for Arrays on huge pages, see HugePages. E.g. Dynamic::Array<float[3], Allocator<HugePageAllocator>>.
+
+template <typename T, std::size_t alignment>
+struct HugePageAllocator
+{
+private:
+
+    static constexpr std::size_t alignment_ = alignment > alignof(T) ? alignment : alignof(T);
+
+public:
+
+    static T *allocate(std::size_t n)
+    {   return static_cast<T *>(HugePages::allocate(n * sizeof(T), alignment_));
+    }
+
+    static void deallocate(T *p) noexcept
+    {   HugePages::deallocate(p);
+    }
+};
+
+}
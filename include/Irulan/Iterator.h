@@ -0,0 +1,173 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include "Type.h"
+
+namespace Irulan
+{
+
+//  Iterator over the elements of an Array in memory order, that keeps track of the indexes of the element. Instead of
+//  calculating the memory index from the indexes, the indexes are updated from the previous ones, like an odometer, with
+//  the bounds of the layout. So it only exists for layouts where memory order is a nesting of loops over the indexes,
+//  i.e. conventional and packed.
+//  Dereferencing gives an Element, which can be used as e.g. for (auto [index, value] : A.indexed()). The Element is a
+//  proxy that refers to the indexes kept in the iterator, so it's only valid until the iterator moves on, and this is an
+//  input iterator rather than a forward one.
+
+template <typename Array, typename T>
+struct IndexIterator
+{
+
+private:
+
+    static constexpr LayoutEnum  layout = Array::layout;
+    static constexpr AxisEnum    axis   = Array::axis;
+    static constexpr std::size_t order  = Array::order;
+    using size_type = typename Array::size_type;
+
+    static_assert(layout == conventional || layout == packed_inc || layout == packed_dec,
+        "indexed iteration only exists for layouts stored in index order");
+
+
+
+public:
+
+    struct Element
+    {   const std::array<size_type, order>& index;
+        T& value;
+    };
+
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = Element;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = Element;
+
+
+
+private:
+
+    T *data;
+    std::array<size_type, order> dims;
+    std::array<size_type, order> index {};
+
+
+
+public:
+
+    //  For packed layouts only the 1st dim is used.
+
+    IndexIterator(T *data, const std::array<size_type, order>& dims) noexcept
+        : data {data}, dims {dims}
+    {
+    }
+
+
+
+public:
+
+    Element operator*() const noexcept
+    {   return {index, *data};
+    }
+
+    IndexIterator& operator++() noexcept
+    {   data++;
+        advance<0>();
+        return *this;
+    }
+
+    IndexIterator operator++(int) noexcept
+    {   IndexIterator result = *this;
+        ++*this;
+        return result;
+    }
+
+    //  Iterators are compared by their data only, which is what the end iterator is made with.
+
+    friend bool operator==(const IndexIterator& a, const IndexIterator& b) noexcept
+    {   return a.data == b.data;
+    }
+
+    friend bool operator!=(const IndexIterator& a, const IndexIterator& b) noexcept
+    {   return a.data != b.data;
+    }
+
+
+
+private:
+
+    //  Step the index at some position, fastest first. When it reaches its upper bound, step the next one and restart from
+    //  the lower bound, which for packed layouts depends on the next index.
+
+    template <std::size_t position>
+    void advance() noexcept
+    {   constexpr std::size_t level = axis == column ? position : order - 1 - position;
+        constexpr std::size_t next  = axis == column ? position + 1 : order - 2 - position;
+        index[level]++;
+        if constexpr (position + 1 != order)
+        {   if constexpr (layout == conventional)
+            {   if (index[level] < dims[level])
+                    return;
+                advance<position + 1>();
+                index[level] = 0;
+            }
+            else if constexpr (layout == packed_inc)
+            {   if (index[level] <= index[next])
+                    return;
+                advance<position + 1>();
+                index[level] = 0;
+            }
+            else if constexpr (layout == packed_dec)
+            {   if (index[level] < dims[0])
+                    return;
+                advance<position + 1>();
+                index[level] = index[next];
+            }
+        }
+    }
+};
+
+
+
+//  The range of an IndexIterator, to be used in range based for loops and the like.
+
+template <typename Iterator>
+struct IndexRange
+{   Iterator begin_, end_;
+
+    Iterator begin() const noexcept
+    {   return begin_;
+    }
+
+    Iterator end() const noexcept
+    {   return end_;
+    }
+};
+
+}
@@ -0,0 +1,206 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#pragma once
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "File.h"
+
+namespace Irulan
+{
+
+//  Hints to the OS about how the data will be accessed, so it can read ahead (sequential), not read ahead (random), or start
+//  reading right away (will_need).
+
+enum class Advice {normal, sequential, random, will_need};
+
+
+
+//  Mapping of an Irulan file (see File.h) into memory. It's a wrapper (Allocate<false>) of the Array type, so it's used like
+//  one, but owns the mapping. The OS pages the data in as it's used, so opening is immediate no matter the size.
+//  With a const value type (e.g. Dynamic::Array<const float[3]>) the file is mapped read only, so the data can't be written
+//  through it. Otherwise it's mapped read write, and changes go to the file.
+//  This uses POSIX mmap. Failures of the OS throw std::system_error, invalid files std::runtime_error.
+
+template <typename Array>
+struct Mapping : Array::wrapper_type
+{
+
+private:
+
+    using Wrapper = typename Array::wrapper_type;
+
+    static constexpr bool read_only = std::is_const_v<typename Array::value_type>;
+
+    void *base;
+    std::size_t length;
+
+
+
+private:
+
+    Mapping(const Wrapper& A, void *base, std::size_t length) noexcept
+        : Wrapper {A}, base {base}, length {length}
+    {
+    }
+
+
+
+public:
+
+    //  Create a file for an Array with some dims (as given to its constructor), and map it.
+
+    template <typename ...Dims>
+    static Mapping create(const std::string& path, Dims... dims)
+    {   static_assert(!read_only, "a created file has to be written, its value type can't be const");
+        const File::Header header = File::make_header<Array>(dims...);
+        const std::size_t length = header.data_offset + File::data_bytes<Array>(header);
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1)
+            throw std::system_error {errno, std::generic_category(), "can't create " + path};
+        if (::ftruncate(fd, length) == -1)
+        {   const int error = errno;
+            ::close(fd);
+            throw std::system_error {error, std::generic_category(), "can't resize " + path};
+        }
+        void *base = map(fd, length, path);
+        File::write_header(static_cast<char *>(base), header);
+        Wrapper A {dims...};
+        A() = reinterpret_cast<typename Array::value_type *>(static_cast<char *>(base) + header.data_offset);
+        return Mapping {A, base, length};
+    }
+
+    //  Map an existing file.
+
+    static Mapping open(const std::string& path, Advice advice = Advice::normal)
+    {   return open(path, advice, [](char *base, std::size_t length)
+            {   const File::Header header = File::read_header(base, length);
+                File::check_header<Array>(header);
+                if (length < header.data_offset || length - header.data_offset < File::data_bytes<Array>(header))
+                    throw std::runtime_error {"Irulan file is truncated"};
+                Wrapper A = File::apply_dims<Array>(header, [](auto... dims){ return Wrapper {dims...}; });
+                A() = reinterpret_cast<typename Array::value_type *>(base + header.data_offset);
+                return A;
+            });
+    }
+
+    //  Map an existing file of another format (see e.g. Npy.h). Locate is given the bytes of the file, and returns the
+    //  wrapper of the data in them, or throws if the file doesn't hold an Array of this type.
+
+    template <typename Locate>
+    static Mapping open(const std::string& path, Advice advice, Locate locate)
+    {   const int fd = ::open(path.c_str(), read_only ? O_RDONLY : O_RDWR);
+        if (fd == -1)
+            throw std::system_error {errno, std::generic_category(), "can't open " + path};
+        struct stat status;
+        if (::fstat(fd, &status) == -1)
+        {   const int error = errno;
+            ::close(fd);
+            throw std::system_error {error, std::generic_category(), "can't stat " + path};
+        }
+        const std::size_t length = status.st_size;
+        void *base = map(fd, length, path);
+        try
+        {   Mapping M {locate(static_cast<char *>(base), static_cast<std::size_t>(length)), base, length};
+            M.advise(advice);
+            return M;
+        }
+        catch (...)
+        {   ::munmap(base, length);
+            throw;
+        }
+    }
+
+
+
+public:
+
+    Mapping(const Mapping&) = delete;
+
+    Mapping(Mapping&& M) noexcept
+        : Wrapper {static_cast<const Wrapper&>(M)}, base {M.base}, length {M.length}
+    {   M.base = NULL;
+    }
+
+    Mapping& operator=(const Mapping&) = delete;
+
+    Mapping& operator=(Mapping&& M) noexcept
+    {   if (this != &M)
+        {   if (base != NULL)
+                ::munmap(base, length);
+            Wrapper::operator=(static_cast<const Wrapper&>(M));
+            base = M.base;
+            length = M.length;
+            M.base = NULL;
+        }
+        return *this;
+    }
+
+    ~Mapping() noexcept
+    {   if (base != NULL)
+            ::munmap(base, length);
+    }
+
+
+
+public:
+
+    //  Give the OS a hint about how the data will be accessed from now on.
+
+    void advise(Advice advice) noexcept
+    {   static constexpr int advices[] {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED};
+        ::madvise(base, length, advices[static_cast<int>(advice)]);
+    }
+
+    //  Write changes to the file now, instead of whenever the OS decides to.
+
+    void sync()
+    {   if (::msync(base, length, MS_SYNC) == -1)
+            throw std::system_error {errno, std::generic_category(), "can't sync mapping"};
+    }
+
+
+
+private:
+
+    //  Map a whole file. The file descriptor is closed, the mapping stays valid without it.
+
+    static void *map(int fd, std::size_t length, const std::string& path)
+    {   void *base = ::mmap(NULL, length, read_only ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);
+        if (base == MAP_FAILED)
+            throw std::system_error {error, std::generic_category(), "can't map " + path};
+        return base;
+    }
+};
+
+}
@@ -0,0 +1,194 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace Irulan
+{
+
+//  Allocators are class templates of the value type and the alignment, with a static allocate and deallocate function.
+//  Array doesn't hold an allocator object, so allocators that need state (e.g. a pool) keep it somewhere else.
+//  Deallocation isn't given the size, because the dims of a Dynamic::Array can be reinterpreted, and with EfficientShape
+//  not all of them are stored.
+
+//  The default allocator, which uses new. Alignments beyond what new guarantees use the aligned new.
+
+template <typename T, std::size_t alignment>
+struct HeapAllocator
+{
+private:
+
+    static constexpr std::size_t alignment_ = alignment > alignof(T) ? alignment : alignof(T);
+    static constexpr bool aligned_new = alignment_ > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+public:
+
+    static T *allocate(std::size_t n)
+    {   if constexpr (aligned_new)
+            return static_cast<T *>(::operator new[](n * sizeof(T), std::align_val_t {alignment_}));
+        else
+            return new T[n];
+    }
+
+    static void deallocate(T *p) noexcept
+    {   if constexpr (aligned_new)
+            ::operator delete[](p, std::align_val_t {alignment_});
+        else
+            delete[] p;
+    }
+};
+
+
+
+//  Arena to bump allocate from, e.g. for many small Arrays that are all released at once. Memory is taken in chunks, and
+//  reset rewinds to the start without giving the chunks back, so after the 1st time no new pages are touched. Arrays that
+//  use it must be gone before a reset. An Arena is meant for one thread.
+
+struct Arena
+{
+
+private:
+
+    static constexpr std::size_t chunk_alignment = 64;
+
+    struct Chunk
+    {   char *data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    std::size_t chunk = 0;
+    std::size_t used = 0;
+    std::size_t chunk_size;
+
+    static Arena *&scoped() noexcept
+    {   thread_local Arena *arena = nullptr;
+        return arena;
+    }
+
+
+
+public:
+
+    explicit Arena(std::size_t chunk_size = std::size_t {1} << 20) noexcept
+        : chunk_size {chunk_size}
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() noexcept
+    {   for (Chunk& c : chunks)
+            ::operator delete[](c.data, std::align_val_t {chunk_alignment});
+    }
+
+    void *allocate(std::size_t bytes, std::size_t alignment)
+    {   for (; chunk != chunks.size(); chunk++, used = 0)
+        {   const Chunk& c = chunks[chunk];
+            const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(c.data);
+            const std::size_t offset = (start + used + alignment - 1) / alignment * alignment - start;
+            if (offset + bytes <= c.size)
+            {   used = offset + bytes;
+                return c.data + offset;
+            }
+        }
+        const std::size_t size = bytes + alignment > chunk_size ? bytes + alignment : chunk_size;
+        chunks.push_back({static_cast<char *>(::operator new[](size, std::align_val_t {chunk_alignment})), size});
+        return allocate(bytes, alignment);
+    }
+
+    //  Release everything allocated, but keep the memory for what comes next.
+
+    void reset() noexcept
+    {   chunk = 0;
+        used = 0;
+    }
+
+    //  Bytes held in chunks.
+
+    std::size_t capacity() const noexcept
+    {   std::size_t result = 0;
+        for (const Chunk& c : chunks)
+            result += c.size;
+        return result;
+    }
+
+
+
+public:
+
+    //  The arena of the calling thread, that ArenaAllocator allocates from. That's the innermost Scope's, otherwise a
+    //  thread_local one.
+
+    static Arena& active() noexcept
+    {   thread_local Arena local;
+        return scoped() != nullptr ? *scoped() : local;
+    }
+
+    //  Makes an arena the active one of the calling thread while it exists.
+
+    struct Scope
+    {   Arena *previous;
+
+        explicit Scope(Arena& arena) noexcept
+            : previous {scoped()}
+        {   scoped() = &arena;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() noexcept
+        {   scoped() = previous;
+        }
+    };
+};
+
+//  Allocator that bump allocates from the active Arena of the calling thread. Deallocation does nothing, the memory is
+//  released with the arena's reset.
+
+template <typename T, std::size_t alignment>
+struct ArenaAllocator
+{
+private:
+
+    static constexpr std::size_t alignment_ = alignment > alignof(T) ? alignment : alignof(T);
+
+public:
+
+    static T *allocate(std::size_t n)
+    {   return static_cast<T *>(Arena::active().allocate(n * sizeof(T), alignment_));
+    }
+
+    static void deallocate(T *) noexcept
+    {
+    }
+};
+
+}
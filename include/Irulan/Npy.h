@@ -0,0 +1,263 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Dynamic.h"
+#include "File.h"
+#include "Mapping.h"
+
+namespace Irulan
+{   namespace Npy
+    {
+
+//  Reading and writing NumPy .npy files, for conventional Dynamic::Arrays. The shape in the file is the dims in index order,
+//  and fortran_order is true for column major and false for row major. When it matches the axis of the Array, the data is
+//  read (load) or mapped (open) as is, otherwise load transposes it. Version 1.0 is written, 1.0 to 3.0 are read.
+//  Like NumPy's own '<' types, this assumes a little endian machine.
+
+constexpr char magic[6] {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+//  NumPy type string of a value type, e.g. "<f8" for double.
+
+template <typename T>
+std::string descr()
+{   char kind;
+    if constexpr (std::is_same_v<T, bool>)
+        kind = 'b';
+    else if constexpr (std::is_floating_point_v<T>)
+        kind = 'f';
+    else if constexpr (std::is_integral_v<T>)
+        kind = std::is_signed_v<T> ? 'i' : 'u';
+    else
+        static_assert(std::is_arithmetic_v<T>, "value type has no NumPy equivalent");
+    return (sizeof(T) == 1 ? "|" : "<") + std::string {kind} + std::to_string(sizeof(T));
+}
+
+struct Header
+{   std::string descr;
+    bool fortran_order;
+    std::vector<std::uint64_t> shape;
+    std::size_t data_offset;
+};
+
+
+
+//  The start of a file up to the data: magic, version, header length, and the header, a Python dict padded with spaces so
+//  the data starts at a multiple of 64 bytes.
+
+inline std::string write_header(const Header& header)
+{   std::string dict = "{'descr': '" + header.descr + "', 'fortran_order': " + (header.fortran_order ? "True" : "False")
+        + ", 'shape': (";
+    for (std::size_t i = 0; i < header.shape.size(); i++)
+        dict += (i != 0 ? ", " : "") + std::to_string(header.shape[i]);
+    dict += header.shape.size() == 1 ? ",), }" : "), }";
+    const bool large = 10 + dict.size() + 1 + 63 > std::numeric_limits<std::uint16_t>::max();
+    const std::size_t preamble = large ? 12 : 10;
+    dict.resize((preamble + dict.size() + 1 + 63) / 64 * 64 - preamble - 1, ' ');
+    dict += '\n';
+    std::string result {magic, sizeof magic};
+    result += large ? '\x02' : '\x01';
+    result += '\0';
+    for (std::size_t i = 0; i < preamble - 8; i++)
+        result += static_cast<char>(dict.size() >> 8 * i & 0xFF);
+    return result + dict;
+}
+
+//  Size of the start of a file up to the data, from its 1st 12 bytes (or less, if the file is smaller).
+
+inline std::size_t data_offset(const char *p, std::size_t size)
+{   if (size < 10 || std::memcmp(p, magic, sizeof magic) != 0)
+        throw std::runtime_error {"not a NumPy file"};
+    const unsigned char *u = reinterpret_cast<const unsigned char *>(p);
+    if (u[6] == 1)
+        return 10 + (u[8] | u[9] << 8);
+    if ((u[6] != 2 && u[6] != 3) || size < 12)
+        throw std::runtime_error {"unsupported NumPy file version"};
+    return 12 + (u[8] | u[9] << 8 | u[10] << 16 | static_cast<std::size_t>(u[11]) << 24);
+}
+
+//  Reads the header from the 1st size bytes of a file. Throws std::runtime_error if this is no valid header.
+
+inline Header read_header(const char *p, std::size_t size)
+{   Header header {};
+    header.data_offset = data_offset(p, size);
+    if (size < header.data_offset)
+        throw std::runtime_error {"NumPy file header is truncated"};
+    const std::string dict {p, header.data_offset};
+    auto value = [&dict](const char *key)
+        {   std::size_t i = dict.find(std::string {"'"} + key + "'");
+            if (i == std::string::npos || (i = dict.find(':', i)) == std::string::npos ||
+                (i = dict.find_first_not_of(' ', i + 1)) == std::string::npos)
+                throw std::runtime_error {std::string {"NumPy file header has no "} + key};
+            return i;
+        };
+    std::size_t i = value("descr");
+    const std::size_t end = dict.find(dict[i], i + 1);
+    if ((dict[i] != '\'' && dict[i] != '"') || end == std::string::npos)
+        throw std::runtime_error {"NumPy file header has an invalid descr"};
+    header.descr = dict.substr(i + 1, end - i - 1);
+    i = value("fortran_order");
+    header.fortran_order = dict.compare(i, 4, "True") == 0;
+    if (!header.fortran_order && dict.compare(i, 5, "False") != 0)
+        throw std::runtime_error {"NumPy file header has an invalid fortran_order"};
+    i = value("shape");
+    if (dict[i] != '(')
+        throw std::runtime_error {"NumPy file header has an invalid shape"};
+    for (i++; (i = dict.find_first_not_of(", ", i)) != std::string::npos && dict[i] != ')';)
+    {   if (dict[i] < '0' || dict[i] > '9')
+            throw std::runtime_error {"NumPy file header has an invalid shape"};
+        std::size_t n;
+        try
+        {   header.shape.push_back(std::stoull(dict.substr(i), &n));
+        }
+        catch (const std::logic_error&)
+        {   throw std::runtime_error {"NumPy file header has an invalid shape"};
+        }
+        i += n;
+    }
+    if (i == std::string::npos)
+        throw std::runtime_error {"NumPy file header has an invalid shape"};
+    return header;
+}
+
+
+
+//  Checks that a header fits an Array type, except for fortran_order. Throws std::runtime_error if it doesn't, also when
+//  the data size in bytes doesn't fit a std::size_t.
+
+template <typename Array>
+void check_header(const Header& header)
+{   static_assert(Array::layout == conventional, "NumPy files only hold conventional layouts");
+    using size_type = typename Array::size_type;
+    if (header.descr != descr<std::remove_const_t<typename Array::value_type>>())
+        throw std::runtime_error {"NumPy file has a different type, " + header.descr};
+    if (header.shape.size() != Array::order)
+        throw std::runtime_error {"NumPy file has a different order"};
+    constexpr std::uint64_t max = std::numeric_limits<std::size_t>::max();
+    std::uint64_t bytes = sizeof(typename Array::value_type);
+    for (std::uint64_t dim : header.shape)
+    {   if (dim > static_cast<std::uint64_t>(std::numeric_limits<size_type>::max()))
+            throw std::runtime_error {"NumPy file has dims that don't fit the size type"};
+        if (dim != 0 && bytes > max / dim)
+            throw std::runtime_error {"NumPy file has a data size that doesn't fit in memory"};
+        bytes *= dim;
+    }
+}
+
+//  Construct an Array with the shape in a header.
+
+template <typename Array, std::size_t ...i>
+Array construct(const Header& header, std::index_sequence<i...>)
+{   return Array {static_cast<typename Array::size_type>(header.shape[i])...};
+}
+
+template <typename Array>
+Array construct(const Header& header)
+{   return construct<Array>(header, std::make_index_sequence<Array::order> {});
+}
+
+
+
+//  Save a whole Array.
+
+template <typename Array>
+void save(const std::string& path, const Array& A)
+{   static_assert(Array::layout == conventional, "NumPy files only hold conventional layouts");
+    const Header header {descr<typename Array::value_type>(), Array::axis == column,
+        File::array_dims(A, [](auto... dims){ return std::vector<std::uint64_t> {static_cast<std::uint64_t>(dims)...}; }),
+        0};
+    std::ofstream file {path, std::ios::binary | std::ios::trunc};
+    if (!file)
+        throw std::runtime_error {"can't create " + path};
+    const std::string start = write_header(header);
+    file.write(start.data(), start.size());
+    file.write(reinterpret_cast<const char *>(A()), A.size() * sizeof(typename Array::value_type));
+    file.close();
+    if (!file)
+        throw std::runtime_error {"writing failed"};
+}
+
+//  Load an Array. If fortran_order matches the axis, the data is read straight into it, otherwise it's transposed.
+
+template <typename Array>
+typename Array::owner_type load(const std::string& path)
+{   using Owner = typename Array::owner_type;
+    using value_type = typename Array::value_type;
+    std::ifstream file {path, std::ios::binary};
+    if (!file)
+        throw std::runtime_error {"can't open " + path};
+    std::vector<char> bytes(12);
+    file.read(bytes.data(), bytes.size());
+    bytes.resize(data_offset(bytes.data(), file.gcount()));
+    if (bytes.size() < 12)
+        throw std::runtime_error {"NumPy file header is truncated"};
+    file.read(bytes.data() + 12, bytes.size() - 12);
+    const Header header = read_header(bytes.data(), 12 + file.gcount());
+    check_header<Owner>(header);
+    Owner A = construct<Owner>(header);
+    if (header.fortran_order == (Array::axis == column))
+        file.read(reinterpret_cast<char *>(A()), A.size() * sizeof(value_type));
+    else
+    {   using Transposed = Dynamic::Array<value_type[Array::order], Axis<Array::axis == column ? row : column>,
+            SizeType<typename Array::size_type>>;
+        Transposed B = construct<Transposed>(header);
+        file.read(reinterpret_cast<char *>(B()), B.size() * sizeof(value_type));
+        for (auto [index, value] : B.indexed())
+            std::apply(A, index) = value;
+    }
+    if (!file)
+        throw std::runtime_error {"NumPy file is truncated"};
+    return A;
+}
+
+//  Map a file, see Mapping. The fortran_order must match the axis of the Array.
+
+template <typename Array>
+Mapping<Array> open(const std::string& path, Advice advice = Advice::normal)
+{   using Wrapper = typename Array::wrapper_type;
+    return Mapping<Array>::open(path, advice, [](char *base, std::size_t length)
+        {   const Header header = read_header(base, length);
+            check_header<Array>(header);
+            if (header.fortran_order != (Array::axis == column))
+                throw std::runtime_error {"NumPy file has a different axis"};
+            Wrapper A = construct<Wrapper>(header);
+            if (length - header.data_offset < A.size() * sizeof(typename Array::value_type))
+                throw std::runtime_error {"NumPy file is truncated"};
+            A() = reinterpret_cast<typename Array::value_type *>(base + header.data_offset);
+            return A;
+        });
+}
+
+    }
+}
@@ -0,0 +1,332 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Type.h"
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace Irulan
+{   namespace Parallel
+    {
+
+//  Bulk operations on a Dynamic::Array, run in parallel with OpenMP (so compile with OpenMP, otherwise they run on one
+//  thread). Callbacks are given the value, and optionally the indexes: f(value) or f(value, i...), and for fill f(i...).
+//      for_each(A, f)              calls f on every element
+//      fill(A, f)                  sets every element to f(i...), or to f if it's a value
+//      transform(A, B, f)          sets every element of B to f of the element of A, A and B have the same type and dims
+//      reduce(A, init, op[, f])    folds the elements (or f of them) with op, which must be associative
+//  The data is split in one part per thread with the same number of elements, so packed layouts are balanced too.
+//  For conventional and packed layouts these parts are contiguous in memory and walked line by line along the fastest
+//  index. Filling with a value marks those loops for vectorization (omp simd). Loops that call back are left to the compiler
+//  to vectorize, as callbacks may have side effects or depend on each other. Tiled and morton layouts are split by lines
+//  of the index space instead.
+
+
+
+template <typename Array>
+struct Engine
+{
+
+private:
+
+    static constexpr LayoutEnum  layout = Array::layout;
+    static constexpr AxisEnum    axis   = Array::axis;
+    static constexpr std::size_t order  = Array::order;
+    static constexpr bool packed = layout == packed_inc || layout == packed_dec;
+    static constexpr bool in_memory_order = layout == conventional || packed;
+
+    static_assert(!Array::efficient_shape || (packed && order > 1), "the dims of the array must be known");
+    static_assert(layout != aosoa, "elements of the aosoa layout aren't stored as a whole");
+
+    //  Level of the index at some position, fastest first.
+
+    static constexpr std::size_t level(std::size_t position) noexcept
+    {   return axis == column ? position : order - 1 - position;
+    }
+
+    static constexpr std::size_t fast = level(0);
+
+
+
+public:
+
+    using size_type = typename Array::size_type;
+    using Index = std::array<size_type, order>;
+
+    static Index dims(const Array& A) noexcept
+    {   Index dims;
+        for (std::size_t i = 0; i < order; i++)
+            dims[i] = A[packed ? 0 : i];
+        return dims;
+    }
+
+    //  Call f with the index at every position replaced by x at the fastest one, and optionally a value first.
+
+    template <typename F, std::size_t ...j>
+    static decltype(auto) call(F& f, const Index& index, size_type x, std::index_sequence<j...>)
+    {   return f((j == fast ? x : index[j])...);
+    }
+
+    template <typename F, typename V, std::size_t ...j>
+    static decltype(auto) call(F& f, V& value, const Index& index, size_type x, std::index_sequence<j...>)
+    {   if constexpr (std::is_invocable_v<F&, V&, decltype(j, size_type {})...>)
+            return f(value, (j == fast ? x : index[j])...);
+        else
+            return f(value);
+    }
+
+
+public:
+
+    //  Call g(begin, end, thread) on every thread, for equal parts of [0, n).
+
+    template <typename G>
+    static void split(std::size_t n, G g)
+    {
+#if defined(_OPENMP)
+        #pragma omp parallel
+#endif
+        {   std::size_t threads = 1, thread = 0;
+#if defined(_OPENMP)
+            threads = omp_get_num_threads();
+            thread  = omp_get_thread_num();
+#endif
+            g(n * thread / threads, n * (thread + 1) / threads, thread);
+        }
+    }
+
+    static std::size_t max_threads() noexcept
+    {
+#if defined(_OPENMP)
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    //  Call f(thread, k, index, x) for every element, with k the memory index and x the fastest index (the index at the
+    //  fastest position is not up to date). Each thread gets a part of the elements, in memory order. With vectorize, the
+    //  calls along the fastest index must be independent, so it's only for loops of the library itself.
+
+    template <bool vectorize, typename F>
+    static void run(const Array& A, F f)
+    {   const Index dims_ = dims(A);
+        if constexpr (in_memory_order)
+            split(A.size(), [&](std::size_t b, std::size_t e, std::size_t thread)
+                {   lines(A, dims_, b, e, [&](std::size_t k, std::size_t n, const Index& index)
+                        {   const size_type start = index[fast];
+                            if constexpr (vectorize)
+                            {
+#if defined(_OPENMP)
+                                #pragma omp simd
+#endif
+                                for (std::size_t j = 0; j < n; j++)
+                                    f(thread, k + j, index, static_cast<size_type>(start + j));
+                            }
+                            else
+                                for (std::size_t j = 0; j < n; j++)
+                                    f(thread, k + j, index, static_cast<size_type>(start + j));
+                        });
+                });
+        else
+        {   std::size_t n = 1;
+            for (std::size_t i = 0; i < order; i++)
+                if (i != fast)
+                    n *= dims_[i];
+            split(n, [&](std::size_t b, std::size_t e, std::size_t thread)
+                {   for (std::size_t line = b; line < e; line++)
+                    {   Index index {};
+                        for (std::size_t position = 1, rest = line; position < order; position++)
+                        {   index[level(position)] = rest % dims_[level(position)];
+                            rest /= dims_[level(position)];
+                        }
+                        for (size_type x = 0; x < dims_[fast]; x++)
+                        {   index[fast] = x;
+                            f(thread, offset(A, index), index, x);
+                        }
+                    }
+                });
+        }
+    }
+
+
+private:
+
+    static std::ptrdiff_t offset(const Array& A, const Index& index) noexcept
+    {   return &std::apply(A, index) - A();
+    }
+
+    //  Bounds of the index at some position, given the slower indexes.
+
+    template <std::size_t position>
+    static size_type lower(const Index& index) noexcept
+    {   if constexpr (layout == packed_dec && position + 1 != order)
+            return index[level(position + 1)];
+        else
+            return 0;
+    }
+
+    template <std::size_t position>
+    static size_type upper(const Index& index, const Index& dims) noexcept
+    {   if constexpr (layout == packed_inc && position + 1 != order)
+            return index[level(position + 1)];
+        else
+            return dims[level(position)] - 1;
+    }
+
+    //  Index of the element at memory index b. Each index is found by a binary search, from slowest to fastest, with the
+    //  faster indexes at their lower bound.
+
+    template <std::size_t position>
+    static void locate(const Array& A, const Index& dims, std::size_t b, Index& index) noexcept
+    {   size_type lo = lower<position>(index), hi = upper<position>(index, dims);
+        while (lo < hi)
+        {   const size_type mid = lo + (hi - lo + 1) / 2;
+            index[level(position)] = mid;
+            for (std::size_t p = 0; p < position; p++)
+                index[level(p)] = layout == packed_dec ? mid : 0;
+            if (static_cast<std::size_t>(offset(A, index)) <= b)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        index[level(position)] = lo;
+        for (std::size_t p = 0; p < position; p++)
+            index[level(p)] = layout == packed_dec ? lo : 0;
+        if constexpr (position != 0)
+            locate<position - 1>(A, dims, b, index);
+    }
+
+    //  Step the index at some position, with the carry to the slower ones, like IndexIterator.
+
+    template <std::size_t position>
+    static void advance(Index& index, const Index& dims) noexcept
+    {   index[level(position)]++;
+        if constexpr (position + 1 != order)
+            if (index[level(position)] > upper<position>(index, dims))
+            {   advance<position + 1>(index, dims);
+                index[level(position)] = lower<position>(index);
+            }
+    }
+
+    //  Call line(k, n, index) for the lines along the fastest index between memory indexes b and e, with k the memory
+    //  index of the 1st element of the line, n its length, and index that of its 1st element.
+
+    template <typename Line>
+    static void lines(const Array& A, const Index& dims, std::size_t b, std::size_t e, Line line) noexcept
+    {   if (b == e)
+            return;
+        Index index {};
+        locate<order - 1>(A, dims, b, index);
+        while (true)
+        {   const std::size_t n = std::min<std::size_t>(upper<0>(index, dims) - index[fast] + 1, e - b);
+            line(b, n, index);
+            b += n;
+            if (b == e)
+                return;
+            index[fast] += n - 1;
+            advance<0>(index, dims);
+        }
+    }
+};
+
+
+
+template <typename Array, typename F>
+void for_each(Array& A, F f)
+{   using Engine_ = Engine<std::remove_const_t<Array>>;
+    auto *data = A();
+    Engine_::template run<false>(A, [data, &f](std::size_t, std::size_t k, const auto& index, auto x)
+        {   Engine_::call(f, data[k], index, x, std::make_index_sequence<Array::order> {});
+        });
+}
+
+template <typename Array, typename F>
+void fill(Array& A, F f)
+{   using Engine_ = Engine<Array>;
+    auto *data = A();
+    constexpr bool value = std::is_convertible_v<F, typename Array::value_type>;
+    Engine_::template run<value>(A, [data, &f](std::size_t, std::size_t k, const auto& index, auto x)
+        {   if constexpr (value)
+                data[k] = f;
+            else
+                data[k] = Engine_::call(f, index, x, std::make_index_sequence<Array::order> {});
+        });
+}
+
+template <typename ArrayA, typename ArrayB, typename F>
+void transform(const ArrayA& A, ArrayB& B, F f)
+{   using Engine_ = Engine<ArrayB>;
+    static_assert(ArrayA::order == ArrayB::order && ArrayA::layout == ArrayB::layout && ArrayA::axis == ArrayB::axis &&
+        std::is_same_v<decltype(ArrayA::tile), decltype(ArrayB::tile)>, "arrays must have the same data layout");
+    if constexpr (ArrayA::layout == tiled)
+        static_assert([]()
+            {   for (std::size_t i = 0; i < ArrayA::order; i++)
+                    if (ArrayA::tile[i] != ArrayB::tile[i])
+                        return false;
+                return true;
+            }(), "arrays must have the same data layout");
+    const auto *a = A();
+    auto *b = B();
+    Engine_::template run<false>(B, [a, b, &f](std::size_t, std::size_t k, const auto& index, auto x)
+        {   b[k] = Engine_::call(f, a[k], index, x, std::make_index_sequence<ArrayB::order> {});
+        });
+}
+
+template <typename Array, typename T, typename Op, typename F>
+T reduce(const Array& A, T init, Op op, F f)
+{   using Engine_ = Engine<Array>;
+    struct alignas(64) Result
+    {   std::optional<T> value;
+    };
+    std::vector<Result> results(Engine_::max_threads());
+    const auto *data = A();
+    Engine_::template run<false>(A, [data, &op, &f, &results](std::size_t thread, std::size_t k, const auto& index,
+        auto x)
+        {   std::optional<T>& result = results[thread].value;
+            T value = Engine_::call(f, data[k], index, x, std::make_index_sequence<Array::order> {});
+            result = result ? op(*result, value) : value;
+        });
+    for (const Result& result : results)
+        if (result.value)
+            init = op(init, *result.value);
+    return init;
+}
+
+template <typename Array, typename T, typename Op>
+T reduce(const Array& A, T init, Op op)
+{   return reduce(A, init, op, [](const auto& value){ return value; });
+}
+
+    }
+}
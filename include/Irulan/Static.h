@@ -24,6 +24,9 @@
 
 #pragma once
 #include "Base.h"
+#include "View.h"
+#include "Iterator.h"
+#include "Cursor.h"
 
 namespace Irulan
 {   namespace Static
@@ -46,6 +49,7 @@ public:
 
     using Base_::layout,
           Base_::axis,
+          Base_::checked,
           typename Base_::size_type,
           typename Base_::value_type;
     static constexpr std::size_t order = dims.size();
@@ -64,6 +68,8 @@ private:
             }
             return true;
         }(), "packed arrays should have equal sides");
+    static_assert(layout != tiled || Base_::tile.size() == order, "tiled arrays need a tile length per dim");
+    static_assert(layout != aosoa, "the aosoa layout only exists for Dynamic::Array");
 
 
 
@@ -137,11 +143,14 @@ private:
             };
         };
 
-        //  Create the shape of the Array this Array can be seen to contain.
+        //  Create the shape of the Array this Array can be seen to contain. That's all dims but the slowest one, which is the
+        //  last for column major and the 1st for row major.
+
+        static constexpr std::size_t offset = axis == column ? 0 : 1;
 
         template <size_t length, typename T, typename = void>
         struct CreateShape
-        {   using type = typename CreateShape<length, T[dims[length - 1 - std::rank_v<T>]]>::type;
+        {   using type = typename CreateShape<length, T[dims[offset + length - 1 - std::rank_v<T>]]>::type;
         };
 
         template <size_t length, typename T>
@@ -153,7 +162,7 @@ private:
         using ElemShape = typename CreateShape<order - 1, value_type>::type;
         using ElemType = typename ShapeModifier_::template Set<ElemShape>::type;
 
-        ElemType value[dims[order - 1]];
+        ElemType value[dims[axis == column ? order - 1 : 0]];
     };
 
 
@@ -180,6 +189,26 @@ private:
     {   value_type value[Base_::combinations(order + dims[0] - 1, order)];
     };
 
+    //  Layout<tiled> case.
+
+    template <std::size_t order>
+    struct Data<order, tiled>
+    {   value_type value[Base_::TiledIndexing::size([](std::size_t level){ return dims[level]; }, order)];
+    };
+
+    //  Layout<morton> case.
+
+    template <std::size_t order>
+    struct Data<order, morton>
+    {   static constexpr std::size_t dim = []()
+            {   std::size_t result = 0;
+                for (std::size_t dim : dims)
+                    result = dim > result ? dim : result;
+                return result;
+            }();
+        value_type value[Base_::MortonIndexing::size(dim, order)];
+    };
+
 
     Data<order, layout> data;
 
@@ -195,6 +224,19 @@ private:
         static_assert(sizeof...(i) <= order, "must have at most as many indexes as order");
     }
 
+    //  Runtime check for Checked. The given indexes are those of the slowest dims, for a partial index of a layout other
+    //  than conventional the full index it stands for is checked too.
+
+    template <typename ...I>
+    static constexpr void check(I... i)
+    {   if constexpr (checked)
+        {   constexpr std::size_t n = sizeof...(i);
+            Base_::template check_index<n == order>([](std::size_t level) -> std::size_t
+                {   return dims[axis == column ? order - n + level : level];
+                }, std::array<std::size_t, n> {static_cast<std::size_t>(i)...});
+        }
+    }
+
 
 
 public:
@@ -233,7 +275,7 @@ public:
             else
                 return data.value[0]();
         }
-        else if constexpr (layout == packed_inc || layout == packed_dec)
+        else if constexpr (layout == packed_inc || layout == packed_dec || layout == tiled || layout == morton)
             return data.value;
     }
 
@@ -244,7 +286,7 @@ public:
             else
                 return data.value[0]();
         }
-        else if constexpr (layout == packed_inc || layout == packed_dec)
+        else if constexpr (layout == packed_inc || layout == packed_dec || layout == tiled || layout == morton)
             return data.value;
     }
 
@@ -255,37 +297,154 @@ public:
     //  Indexing.
 
     template <typename I, typename ...J>
-    constexpr auto& operator()(I i, J... j) noexcept
+    constexpr auto& operator()(I i, J... j) noexcept(!checked)
     {   index_validity(i, j...);
+        check(i, j...);
         if constexpr (layout == conventional)
         {   if constexpr (sizeof...(j) == 0)
                 return data.value[i];
-            else
+            else if constexpr (axis == column)
                 return (*this)(j...)(i);
+            else
+                return data.value[i](j...);
         }
-        else if constexpr ((layout == packed_inc || layout == packed_dec) && sizeof...(j) + 1 != order)
+        else if constexpr (sizeof...(j) + 1 != order && axis == column)
             return (*this)(0, i, j...);
+        else if constexpr (sizeof...(j) + 1 != order && axis == row)
+            return (*this)(i, j..., 0);
         else if constexpr (layout == packed_inc)
-            return data.value[Base_::PackedIndexing::template C_inc<0>(i, j...)];
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::PackedIndexing::template C_inc<0>(i_...);
+                }, i, j...)];
         else if constexpr (layout == packed_dec)
-            return data.value[Base_::PackedIndexing::template C_dec<0>((*this)[0], i, j...)];
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::PackedIndexing::C_dec(dims[0], i_...);
+                }, i, j...)];
+        else if constexpr (layout == tiled)
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::TiledIndexing::C([](std::size_t level){ return dims[level]; }, i_...);
+                }, i, j...)];
+        else if constexpr (layout == morton)
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::MortonIndexing::C(i_...);
+                }, i, j...)];
     }
 
     template <typename I, typename ...J>
-    constexpr const auto& operator()(I i, J... j) const noexcept
+    constexpr const auto& operator()(I i, J... j) const noexcept(!checked)
     {   index_validity(i, j...);
+        check(i, j...);
         if constexpr (layout == conventional)
         {   if constexpr (sizeof...(j) == 0)
                 return data.value[i];
-            else
+            else if constexpr (axis == column)
                 return (*this)(j...)(i);
+            else
+                return data.value[i](j...);
         }
-        else if constexpr ((layout == packed_inc || layout == packed_dec) && sizeof...(j) + 1 != order)
+        else if constexpr (sizeof...(j) + 1 != order && axis == column)
             return (*this)(0, i, j...);
+        else if constexpr (sizeof...(j) + 1 != order && axis == row)
+            return (*this)(i, j..., 0);
         else if constexpr (layout == packed_inc)
-            return data.value[Base_::PackedIndexing::template C_inc<0>(i, j...)];
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::PackedIndexing::template C_inc<0>(i_...);
+                }, i, j...)];
         else if constexpr (layout == packed_dec)
-            return data.value[Base_::PackedIndexing::template C_dec<0>((*this)[0], i, j...)];
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::PackedIndexing::C_dec(dims[0], i_...);
+                }, i, j...)];
+        else if constexpr (layout == tiled)
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::TiledIndexing::C([](std::size_t level){ return dims[level]; }, i_...);
+                }, i, j...)];
+        else if constexpr (layout == morton)
+            return data.value[Base_::fastest_first([](auto... i_)
+                {   return Base_::MortonIndexing::C(i_...);
+                }, i, j...)];
+    }
+
+
+
+public:
+
+    //  Data size, i.e. the number of elements in memory.
+
+    static constexpr std::size_t size() noexcept
+    {   return sizeof(Data<order, layout>) / sizeof(value_type);
+    }
+
+
+
+public:
+
+    //  Iteration over the data in memory order, which for the conventional layout is every element, fastest index first.
+    //  This is a pointer walk.
+
+    constexpr value_type *begin() noexcept
+    {   return (*this)();
+    }
+
+    constexpr const value_type *begin() const noexcept
+    {   return (*this)();
+    }
+
+    constexpr value_type *end() noexcept
+    {   return (*this)() + size();
+    }
+
+    constexpr const value_type *end() const noexcept
+    {   return (*this)() + size();
+    }
+
+    //  Iteration in memory order that also keeps track of the indexes, see IndexIterator.
+
+    auto indexed() noexcept
+    {   using Iterator = IndexIterator<Array, value_type>;
+        return IndexRange<Iterator> {Iterator {begin(), dims}, Iterator {end(), dims}};
+    }
+
+    auto indexed() const noexcept
+    {   using Iterator = IndexIterator<Array, const value_type>;
+        return IndexRange<Iterator> {Iterator {begin(), dims}, Iterator {end(), dims}};
+    }
+
+    //  Cursor for loops that step one index at a time, see Cursor.
+
+    auto cursor() noexcept
+    {   return Cursor<Array, value_type> {(*this)(), dims};
+    }
+
+    auto cursor() const noexcept
+    {   return Cursor<Array, const value_type> {(*this)(), dims};
+    }
+
+
+
+public:
+
+    //  View of part of this Array, with an argument per dim (see View::Range). Nothing is copied.
+
+    template <typename ...Args>
+    auto view(Args... args)
+    {   view_validity<Args...>();
+        return View::make<axis>((*this)(), dims.data(), Base_::strides(dims).data(), args...);
+    }
+
+    template <typename ...Args>
+    auto view(Args... args) const
+    {   view_validity<Args...>();
+        return View::make<axis>((*this)(), dims.data(), Base_::strides(dims).data(), args...);
+    }
+
+
+
+private:
+
+    template <typename ...Args>
+    static constexpr void view_validity() noexcept
+    {   static_assert(layout == conventional, "views only exist for the conventional layout");
+        static_assert(sizeof...(Args) == order, "views take one argument per dim");
     }
 
 
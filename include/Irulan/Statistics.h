@@ -0,0 +1,99 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace Irulan
+{
+
+//  Access counters of an Array with Instrumented<true>. Each access through indexing is compared with the previous one:
+//  its stride in elements goes in a histogram with power of 2 bins, and its locality is whether it's in the same cache
+//  line, the same page, or further away. The counters aren't atomic, so instrument single threaded runs.
+
+struct AccessStatistics
+{   static constexpr std::size_t line = 64;
+    static constexpr std::size_t page = 4096;
+
+    std::size_t accesses = 0;
+
+    //  strides[0] counts accesses to the same element as the previous one, strides[b] those at a distance of 2^(b-1) up to
+    //  2^b - 1 elements, in either direction.
+
+    std::array<std::size_t, 65> strides {};
+
+    //  Accesses in the same cache line as the previous one, in another line of the same page, and in another page.
+
+    std::size_t same_line = 0;
+    std::size_t same_page = 0;
+    std::size_t far = 0;
+
+    void record(const void *p, std::size_t value_size) noexcept
+    {   const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(p);
+        if (accesses++ != 0)
+        {   const std::uintptr_t distance = address > last ? address - last : last - address;
+            std::size_t bin = 0;
+            for (std::uintptr_t stride = distance / value_size; stride != 0; stride >>= 1)
+                bin++;
+            strides[bin]++;
+            if (address / line == last / line)
+                same_line++;
+            else if (address / page == last / page)
+                same_page++;
+            else
+                far++;
+        }
+        last = address;
+    }
+
+    void reset() noexcept
+    {   *this = AccessStatistics {};
+    }
+
+    //  Fraction of accesses that stayed in the cache line of the previous one.
+
+    double locality() const noexcept
+    {   return accesses > 1 ? static_cast<double>(same_line) / (accesses - 1) : 1;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const AccessStatistics& statistics)
+    {   out << "accesses " << statistics.accesses << ", same line " << statistics.same_line << ", same page "
+            << statistics.same_page << ", far " << statistics.far << ", strides";
+        for (std::size_t bin = 0; bin < statistics.strides.size(); bin++)
+            if (statistics.strides[bin] != 0)
+                out << " " << (bin == 0 ? 0 : std::size_t {1} << (bin - 1)) << (bin > 1 ? "+: " : ": ") << statistics.strides[bin];
+        return out;
+    }
+
+
+
+private:
+
+    std::uintptr_t last = 0;
+};
+
+}
@@ -0,0 +1,358 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "Type.h"
+
+namespace Irulan
+{
+
+//  A box of indexes of an Array, begin inclusive and end exclusive per index.
+
+template <typename size_type, std::size_t order>
+struct Block
+{   std::array<size_type, order> begin, end;
+};
+
+
+
+//  Work stealing thread pool for traversing Arrays in blocks. The blocks are sized to fit a cache (from the value type and
+//  dims), and handed out in memory order: each thread starts with a contiguous range of them, and when it runs out it steals
+//  half of what's left of another thread's range. So blocks that cost more (e.g. because of masks, or the triangles of
+//  packed layouts) are balanced while running, where a static schedule would leave threads idle.
+//  The calling thread works too, so a pool of n threads has n - 1 of its own. Link with Threads::Threads.
+
+struct ThreadPool
+{
+
+private:
+
+    //  The range of tasks of a thread. The owner takes from the front, thieves from the back.
+
+    struct alignas(64) Queue
+    {   std::mutex mutex;
+        std::size_t begin = 0, end = 0;
+    };
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<Queue[]> queues;
+
+    std::mutex mutex, caller;
+    std::condition_variable start, done;
+    const std::function<void(std::size_t)> *task = nullptr;
+    std::exception_ptr exception;
+    std::size_t generation = 0;
+    std::size_t running = 0;
+    bool stop = false;
+
+    //  The pool whose task the current thread is running, if any.
+
+    static inline thread_local const ThreadPool *current = nullptr;
+
+
+
+public:
+
+    explicit ThreadPool(std::size_t n = std::max(1u, std::thread::hardware_concurrency()))
+        : queues {new Queue[std::max<std::size_t>(n, 1)]}
+    {   for (std::size_t i = 1; i < n; i++)
+            threads.emplace_back([this, i](){ work(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() noexcept
+    {   {   std::lock_guard<std::mutex> lock {mutex};
+            stop = true;
+        }
+        start.notify_all();
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    //  Number of threads, including the calling one.
+
+    std::size_t size() const noexcept
+    {   return threads.size() + 1;
+    }
+
+
+
+public:
+
+    //  Call f(i) for i in [0, n), and return when all are done. If calls throw, the 1st exception is rethrown.
+    //  Called from a task of this pool (e.g. for_each in for_each), the threads are all busy with the outer run, so
+    //  the calls are made right there, one after the other. Runs from other threads wait for each other, the pool
+    //  serves one caller at a time.
+
+    void run(std::size_t n, const std::function<void(std::size_t)>& f)
+    {   if (current == this)
+        {   for (std::size_t i = 0; i < n; i++)
+                f(i);
+            return;
+        }
+        std::lock_guard<std::mutex> serial {caller};
+        {   std::lock_guard<std::mutex> lock {mutex};
+            for (std::size_t i = 0; i < size(); i++)
+            {   std::lock_guard<std::mutex> lock {queues[i].mutex};
+                queues[i].begin = n * i / size();
+                queues[i].end   = n * (i + 1) / size();
+            }
+            task = &f;
+            exception = nullptr;
+            running = size();
+            generation++;
+        }
+        start.notify_all();
+        drain(0);
+        std::unique_lock<std::mutex> lock {mutex};
+        running--;
+        done.wait(lock, [this](){ return running == 0; });
+        task = nullptr;
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    //  Call f(block) for blocks that cover the indexes of an Array. Blocks hold about block_bytes of data, and span the
+    //  fastest index first, so that for conventional layouts they're mostly contiguous. There are at least a few blocks per
+    //  thread to balance. For packed layouts, blocks that have no valid indexes are left out.
+
+    template <typename Array, typename F>
+    void for_blocks(const Array& A, F f, std::size_t block_bytes = std::size_t {1} << 18)
+    {   using Blocking_ = Blocking<Array>;
+        const auto dims = Blocking_::dims(A);
+        const auto shape = Blocking_::shape(dims, block_bytes, 4 * size());
+        std::array<std::size_t, Array::order> counts;
+        std::size_t n = 1;
+        for (std::size_t i = 0; i < Array::order; i++)
+            n *= counts[i] = (dims[i] + shape[i] - 1) / shape[i];
+        run(n, [&](std::size_t i)
+            {   typename Blocking_::Block_ block;
+                for (std::size_t position = 0; position < Array::order; position++)
+                {   const std::size_t level = Blocking_::level(position);
+                    block.begin[level] = i % counts[level] * shape[level];
+                    block.end[level]   = std::min<std::size_t>(block.begin[level] + shape[level], dims[level]);
+                    i /= counts[level];
+                }
+                if (Blocking_::valid(block))
+                    f(block);
+            });
+    }
+
+    //  Call f(value, i...) for every element of an Array, in blocks as for_blocks. For packed layouts, only for the valid
+    //  indexes.
+
+    template <typename Array, typename F>
+    void for_each(Array& A, F f, std::size_t block_bytes = std::size_t {1} << 18)
+    {   using Blocking_ = Blocking<std::remove_const_t<Array>>;
+        for_blocks(A, [&A, &f](const typename Blocking_::Block_& block)
+            {   typename Blocking_::Index index;
+                Blocking_::template visit<Array::order - 1>(block, index, [&A, &f](const auto& index)
+                    {   std::apply([&A, &f](auto... i){ f(A(i...), i...); }, index);
+                    });
+            }, block_bytes);
+    }
+
+
+
+private:
+
+    //  Blocks of an Array type.
+
+    template <typename Array>
+    struct Blocking
+    {   static constexpr LayoutEnum  layout = Array::layout;
+        static constexpr AxisEnum    axis   = Array::axis;
+        static constexpr std::size_t order  = Array::order;
+        static constexpr bool packed = layout == packed_inc || layout == packed_dec;
+        using size_type = typename Array::size_type;
+        using Index = std::array<size_type, order>;
+        using Block_ = Block<size_type, order>;
+
+        static_assert(!Array::efficient_shape || (packed && order > 1), "the dims of the array must be known");
+
+        static constexpr std::size_t level(std::size_t position) noexcept
+        {   return axis == column ? position : order - 1 - position;
+        }
+
+        static Index dims(const Array& A) noexcept
+        {   Index dims;
+            for (std::size_t i = 0; i < order; i++)
+                dims[i] = A[packed ? 0 : i];
+            return dims;
+        }
+
+        //  Shape of the blocks: as long as possible along the fastest index, then the next and so on, until they hold
+        //  block_bytes. Then the slowest lengths are halved until there are enough blocks.
+
+        static Index shape(const Index& dims, std::size_t block_bytes, std::size_t min_blocks) noexcept
+        {   Index shape;
+            std::size_t elements = std::max<std::size_t>(block_bytes / sizeof(typename Array::value_type), 1);
+            for (std::size_t position = 0; position < order; position++)
+            {   const std::size_t level_ = level(position);
+                shape[level_] = std::max<std::size_t>(std::min<std::size_t>(dims[level_], elements), 1);
+                elements = std::max<std::size_t>(elements / shape[level_], 1);
+            }
+            for (std::size_t position = order; position-- != 0;)
+            {   const std::size_t level_ = level(position);
+                while (blocks(dims, shape) < min_blocks && shape[level_] > 1)
+                    shape[level_] = (shape[level_] + 1) / 2;
+            }
+            return shape;
+        }
+
+        static std::size_t blocks(const Index& dims, const Index& shape) noexcept
+        {   std::size_t n = 1;
+            for (std::size_t i = 0; i < order; i++)
+                n *= (std::max<std::size_t>(dims[i], 1) + shape[i] - 1) / shape[i];
+            return n;
+        }
+
+        //  Whether a block has valid indexes, i.e. for packed_inc the indexes can be increasing from fastest to slowest
+        //  (decreasing for packed_dec). Taking each index as small (large) as possible and checking the next shows so.
+
+        static bool valid(const Block_& block) noexcept
+        {   for (std::size_t i = 0; i < order; i++)
+                if (block.begin[i] >= block.end[i])
+                    return false;
+            if constexpr (packed)
+            {   std::size_t previous = layout == packed_inc ? block.begin[level(0)] : block.end[level(0)] - 1;
+                for (std::size_t position = 1; position < order; position++)
+                {   const std::size_t level_ = level(position);
+                    if (layout == packed_inc)
+                    {   if (block.end[level_] <= previous)
+                            return false;
+                        previous = std::max<std::size_t>(previous, block.begin[level_]);
+                    }
+                    else
+                    {   if (block.begin[level_] > previous)
+                            return false;
+                        previous = std::min<std::size_t>(previous, block.end[level_] - 1);
+                    }
+                }
+            }
+            return true;
+        }
+
+        //  Call f(index) for the valid indexes of a block, from the slowest position down. For packed layouts the range
+        //  of each index is clipped by the next slower one.
+
+        template <std::size_t position, typename F>
+        static void visit(const Block_& block, Index& index, F f)
+        {   constexpr std::size_t level_ = level(position);
+            size_type begin = block.begin[level_], end = block.end[level_];
+            if constexpr (layout == packed_inc && position + 1 != order)
+                end = std::min<size_type>(end, index[level(position + 1)] + 1);
+            if constexpr (layout == packed_dec && position + 1 != order)
+                begin = std::max<size_type>(begin, index[level(position + 1)]);
+            for (index[level_] = begin; index[level_] < end; index[level_]++)
+                if constexpr (position == 0)
+                    f(index);
+                else
+                    visit<position - 1>(block, index, f);
+        }
+    };
+
+
+
+private:
+
+    void work(std::size_t id)
+    {   std::size_t seen = 0;
+        while (true)
+        {   {   std::unique_lock<std::mutex> lock {mutex};
+                start.wait(lock, [this, seen](){ return stop || generation != seen; });
+                if (stop)
+                    return;
+                seen = generation;
+            }
+            drain(id);
+            std::lock_guard<std::mutex> lock {mutex};
+            if (--running == 0)
+                done.notify_one();
+        }
+    }
+
+    //  Run tasks until there are none left, own ones first, then stolen ones.
+
+    void drain(std::size_t id) noexcept
+    {   const ThreadPool *previous = current;
+        current = this;
+        std::size_t i;
+        while (pop(id, i) || (steal(id) && pop(id, i)))
+        {   try
+            {   (*task)(i);
+            }
+            catch (...)
+            {   std::lock_guard<std::mutex> lock {mutex};
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+        current = previous;
+    }
+
+    bool pop(std::size_t id, std::size_t& i) noexcept
+    {   std::lock_guard<std::mutex> lock {queues[id].mutex};
+        if (queues[id].begin == queues[id].end)
+            return false;
+        i = queues[id].begin++;
+        return true;
+    }
+
+    //  Steal the back half of the tasks of the 1st thread after this one that has any.
+
+    bool steal(std::size_t id) noexcept
+    {   for (std::size_t j = 1; j < size(); j++)
+        {   Queue& victim = queues[(id + j) % size()];
+            std::size_t begin, end;
+            {   std::lock_guard<std::mutex> lock {victim.mutex};
+                if (victim.begin == victim.end)
+                    continue;
+                begin = victim.end - (victim.end - victim.begin + 1) / 2;
+                end = victim.end;
+                victim.end = begin;
+            }
+            std::lock_guard<std::mutex> lock {queues[id].mutex};
+            queues[id].begin = begin;
+            queues[id].end = end;
+            return true;
+        }
+        return false;
+    }
+};
+
+}
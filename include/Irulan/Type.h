@@ -23,6 +23,8 @@
 */
 
 #pragma once
+#include <cstddef>
+#include <array>
 
 namespace Irulan
 {
@@ -47,9 +49,14 @@ struct ShapeBase
 //  type, e.g. symmetric and square triangular matrices both have a packed layout. The packed_inc type is for packed storage
 //  with an increasing number of elements per section, and packed_dec for decreasing. They're effectively the same, only the
 //  indexing is different. The former is used for e.g. upper triangular storage for column major matrices, but also lower
-//  triangular storage for row major matrices.
+//  triangular storage for row major matrices. The tiled layout stores the data in tiles (blocks) of a fixed shape, given by
+//  the Tile property, one after the other; within a tile and among tiles the data is stored conventionally. The morton
+//  layout stores the data along the Z-order curve, so elements that are close in all dims are close in memory. The aosoa
+//  layout (array of structures of arrays) is for value types that are structures, like template <typename T> struct
+//  Vec {T x, y, z;}: elements are stored conventionally in blocks of the Lanes property, and within a block each member is
+//  stored as an array. So the same member of neighbouring elements is contiguous, for SIMD.
 
-enum LayoutEnum {conventional, packed_inc, packed_dec};
+enum LayoutEnum {conventional, packed_inc, packed_dec, tiled, morton, aosoa};
 
 struct LayoutBase
 {
@@ -62,9 +69,10 @@ struct Layout : LayoutBase
 
 
 
-//  The axis refers to column or row major storage, i.e. the axis on which data appends in memory.
+//  The axis refers to column or row major storage, i.e. the axis on which data appends in memory. For column major the 1st
+//  index runs fastest through memory, for row major the last.
 
-enum AxisEnum {column};
+enum AxisEnum {column, row};
 
 struct AxisBase
 {
@@ -77,6 +85,51 @@ struct Axis : AxisBase
 
 
 
+//  The tile property gives the shape of the tiles of Layout<tiled>, a length per dim.
+
+struct TileBase
+{
+};
+
+template <std::size_t ...tile>
+struct Tile : TileBase
+{   static_assert(((tile != 0) && ...), "tiles can't be empty");
+    static constexpr std::array<std::size_t, sizeof...(tile)> value {tile...};
+};
+
+
+
+//  The lanes property gives the number of elements per block of Layout<aosoa>, e.g. the SIMD width of the member type.
+
+struct LanesBase
+{
+};
+
+template <std::size_t lanes>
+struct Lanes : LanesBase
+{   static_assert(lanes != 0 && (lanes & (lanes - 1)) == 0, "lanes must be a power of 2");
+    static constexpr std::size_t value = lanes;
+};
+
+
+
+//  The extents property fixes dims of a Dynamic::Array at compile time, one per dim, with dyn for those that are only
+//  known at runtime, e.g. Extents<dyn, dyn, 3> for images that always have 3 channels. Fixed dims aren't stored, and the
+//  index math uses them as constants.
+
+constexpr std::size_t dyn = ~std::size_t {0};
+
+struct ExtentsBase
+{
+};
+
+template <std::size_t ...extents>
+struct Extents : ExtentsBase
+{   static constexpr std::array<std::size_t, sizeof...(extents)> value {extents...};
+};
+
+
+
 //  The allocate property is used to distinguish the usual Array's that hold data from ones that wrap existing data.
 
 struct AllocateBase
@@ -90,6 +143,107 @@ struct Allocate : AllocateBase
 
 
 
+//  The alignment property gives the alignment in bytes of the data a Dynamic::Array allocates, e.g. 64 for cache lines or
+//  1 << 21 for huge pages. The default is what new gives anyway.
+
+struct AlignmentBase
+{
+};
+
+template <std::size_t alignment>
+struct Alignment : AlignmentBase
+{   static_assert(alignment != 0 && (alignment & (alignment - 1)) == 0, "alignment must be a power of 2");
+    static constexpr std::size_t value = alignment;
+};
+
+
+
+//  The allocator property gives the allocator a Dynamic::Array allocates with. It's a class template of the value type and
+//  the alignment, see Memory.h for what it should look like.
+
+struct AllocatorBase
+{
+};
+
+template <template <typename, std::size_t> typename allocator>
+struct Allocator : AllocatorBase
+{   template <typename value_type, std::size_t alignment>
+    using type = allocator<value_type, alignment>;
+};
+
+
+
+//  With first touch, a Dynamic::Array initializes its data in parallel (OpenMP, static schedule) right after allocating.
+//  Memory pages are placed on the NUMA node of the thread that touches them first, so loops with the same schedule later
+//  find their part of the data local.
+
+struct FirstTouchBase
+{
+};
+
+template <bool first_touch>
+struct FirstTouch : FirstTouchBase
+{   static constexpr bool value = first_touch;
+};
+
+
+
+//  With an inline capacity, a Dynamic::Array stores up to that many elements in the object itself instead of allocating,
+//  e.g. for many small matrices of which the size is only known at runtime. Larger data is allocated as usual.
+
+struct InlineCapacityBase
+{
+};
+
+template <std::size_t capacity>
+struct InlineCapacity : InlineCapacityBase
+{   static constexpr std::size_t value = capacity;
+};
+
+
+
+//  With the checked property, indexing an Array checks the indexes at runtime and throws std::out_of_range for those
+//  outside the dims, or outside the triangle of packed layouts. For debug builds, it costs a branch per index.
+
+struct CheckedBase
+{
+};
+
+template <bool checked>
+struct Checked : CheckedBase
+{   static constexpr bool value = checked;
+};
+
+
+
+//  With the instrumented property, a Dynamic::Array counts its element accesses through indexing, with histograms of the
+//  strides between them and of their locality, see AccessStatistics. For finding arrays with poor access patterns.
+
+struct InstrumentedBase
+{
+};
+
+template <bool instrumented>
+struct Instrumented : InstrumentedBase
+{   static constexpr bool value = instrumented;
+};
+
+
+
+//  With the growable property, a Dynamic::Array with the conventional layout can grow along the dim of the slowest index,
+//  e.g. a time series appending a slice per step. It keeps a capacity that grows geometrically, like std::vector.
+
+struct GrowableBase
+{
+};
+
+template <bool growable>
+struct Growable : GrowableBase
+{   static constexpr bool value = growable;
+};
+
+
+
 //  The size type property specifies the type to use for specifying the Array's shape.
 
 struct SizeTypeBase
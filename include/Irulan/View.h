@@ -0,0 +1,221 @@
+/*
+    MIT License
+
+    Copyright (c) 2021 Olaf Willocx
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+
+#pragma once
+#include <stdexcept>
+#include "Base.h"
+
+namespace Irulan
+{   namespace View
+    {
+
+//  Arguments that select part of a dim when making a view. A Range keeps the dim from begin up to (not including) end, with
+//  some step, which can't be 0. All keeps the whole dim. An index (of any integral type) drops the dim.
+
+struct Range
+{   std::size_t begin, end, step = 1;
+};
+
+struct All
+{
+};
+
+inline constexpr All all {};
+
+
+
+template <AxisEnum axis, typename size_type, typename value_type, typename ...Args>
+auto make(value_type *data, const size_type *dims, const std::ptrdiff_t *strides, Args... args);
+
+
+
+//  View::Array has runtime size and doesn't own its data. It has the conventional layout, but with a stride per dim, so
+//  that it can be any regular part of another Array. It's made with view (of e.g. Dynamic::Array), and indexes the same.
+//  Like a pointer, a const View::Array still gives access to the data.
+
+template <typename ...Properties>
+struct Array : Base<Properties...>
+{
+
+private:
+
+    using Base_ = Base<Properties...>;
+
+
+
+public:
+
+    using Base_::layout,
+          Base_::axis,
+          typename Base_::size_type,
+          typename Base_::value_type;
+    static constexpr std::size_t order = Base_::dims[0];
+
+
+
+private:
+
+    //  Some early compile time checks for incorrect use.
+
+    static_assert(Base_::dims.size() == 1, "views template their order, and should only have one");
+    static_assert(layout == conventional, "views only exist for the conventional layout");
+
+
+
+private:
+
+    value_type *data;
+    size_type dims[order];
+    std::ptrdiff_t strides[order];
+
+
+
+private:
+
+    //  Compile time checks for incorrect use.
+
+    template <typename ...I>
+    static constexpr void index_validity(I... i) noexcept
+    {   static_assert((std::is_integral_v<I> && ...), "index types must be integral");
+        static_assert(sizeof...(i) <= order, "must have at most as many indexes as order");
+    }
+
+
+
+public:
+
+    Array(value_type *data, const size_type *dims, const std::ptrdiff_t *strides) noexcept
+        : data {data}
+    {   for (std::size_t i = 0; i < order; i++)
+        {   this->dims[i] = dims[i];
+            this->strides[i] = strides[i];
+        }
+    }
+
+
+
+public:
+
+    //  Dimension operator.
+
+    template <typename I>
+    const size_type& operator[](I i) const noexcept
+    {   index_validity(i);
+        return dims[i];
+    }
+
+    //  Stride of a dim, in elements.
+
+    template <typename I>
+    std::ptrdiff_t stride(I i) const noexcept
+    {   index_validity(i);
+        return strides[i];
+    }
+
+
+
+public:
+
+    //  Raw data access, to the 1st element.
+
+    value_type *operator()() const noexcept
+    {   return data;
+    }
+
+
+
+public:
+
+    //  Indexing. Missing indexes are those that run fastest, and are taken 0.
+
+    template <typename ...I>
+    value_type& operator()(I... i) const noexcept
+    {   index_validity(i...);
+        if constexpr (sizeof...(i) != order && axis == column)
+            return (*this)(0, i...);
+        else if constexpr (sizeof...(i) != order && axis == row)
+            return (*this)(i..., 0);
+        else
+            return data[index(std::make_index_sequence<order> {}, i...)];
+    }
+
+
+
+public:
+
+    //  View of part of this view.
+
+    template <typename ...Args>
+    auto view(Args... args) const
+    {   static_assert(sizeof...(args) == order, "views take one argument per dim");
+        return make<axis>(data, dims, strides, args...);
+    }
+
+
+
+private:
+
+    template <std::size_t ...level, typename ...I>
+    std::ptrdiff_t index(std::index_sequence<level...>, I... i) const noexcept
+    {   return ((static_cast<std::ptrdiff_t>(i) * strides[level]) + ...);
+    }
+};
+
+
+
+//  Make a view of strided data with some dims, selecting part of each dim with the arguments (see Range). Throws
+//  std::invalid_argument for a Range with step 0.
+
+template <AxisEnum axis, typename size_type, typename value_type, typename ...Args>
+auto make(value_type *data, const size_type *dims, const std::ptrdiff_t *strides, Args... args)
+{   static_assert(((std::is_integral_v<Args> || std::is_same_v<Args, Range> || std::is_same_v<Args, All>) && ...),
+        "view arguments must be indexes, Range or all");
+    constexpr std::size_t order = ((std::is_integral_v<Args> ? 0 : 1) + ...);
+    static_assert(order != 0, "views must keep at least one dim");
+
+    size_type dims_[order];
+    std::ptrdiff_t strides_[order];
+    std::size_t level = 0, level_ = 0;
+    ([&](auto arg)
+        {   if constexpr (std::is_integral_v<decltype(arg)>)
+                data += static_cast<std::ptrdiff_t>(arg) * strides[level];
+            else if constexpr (std::is_same_v<decltype(arg), Range>)
+            {   if (arg.step == 0)
+                    throw std::invalid_argument {"ranges of a view need a step of at least 1"};
+                data += static_cast<std::ptrdiff_t>(arg.begin) * strides[level];
+                dims_[level_] = arg.end > arg.begin ? (arg.end - arg.begin + arg.step - 1) / arg.step : 0;
+                strides_[level_++] = strides[level] * static_cast<std::ptrdiff_t>(arg.step);
+            }
+            else
+            {   dims_[level_] = dims[level];
+                strides_[level_++] = strides[level];
+            }
+            level++;
+        }(args), ...);
+    return Array<value_type[order], Axis<axis>, SizeType<size_type>> {data, dims_, strides_};
+}
+
+    }
+}
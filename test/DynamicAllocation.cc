@@ -0,0 +1,49 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{   std::size_t allocations = 0, deallocations = 0;
+}
+
+template <typename T, std::size_t alignment>
+struct CountingAllocator
+{   static T *allocate(std::size_t n)
+    {   allocations++;
+        return Irulan::HeapAllocator<T, alignment>::allocate(n);
+    }
+    static void deallocate(T *p) noexcept
+    {   deallocations++;
+        Irulan::HeapAllocator<T, alignment>::deallocate(p);
+    }
+};
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<float[3], Alignment<64>> A {3, 5, 7};
+        if (reinterpret_cast<std::uintptr_t>(A()) % 64 != 0)
+            return EXIT_FAILURE;
+        A(2, 4, 6) = 1;
+    }
+
+    {   Dynamic::Array<char[1], Alignment<1 << 21>> A {3};
+        if (reinterpret_cast<std::uintptr_t>(A()) % (1 << 21) != 0)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<double[2], Layout<packed_inc>, Allocator<CountingAllocator>> A {4};
+        if (allocations != 1 || deallocations != 0)
+            return EXIT_FAILURE;
+    }
+    if (deallocations != 1)
+        return EXIT_FAILURE;
+
+    {   Dynamic::Array<int[2], FirstTouch<true>, Alignment<4096>> A {100, 100};
+        for (std::size_t j = 0; j < A[1]; j++)
+            for (std::size_t i = 0; i < A[0]; i++)
+                if (A(i, j) != 0)
+                    return EXIT_FAILURE;
+    }
+}
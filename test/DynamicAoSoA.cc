@@ -0,0 +1,50 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+#include <type_traits>
+
+template <typename T>
+struct Vec
+{   T x, y, z;
+};
+
+int main()
+{   using namespace Irulan;
+    using A = Dynamic::Array<Vec<float>[2], Layout<aosoa>, Lanes<4>>;
+
+    A a {3, 5}; // 15 elements, rounded up to 4 blocks of 4
+    if (A::data_size(3, 5) != 16 || a.size() != 16)
+        return EXIT_FAILURE;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 5; j++)
+        {   a(i, j).x = i;
+            a(i, j).y = j;
+            a(i, j).z = i * j;
+        }
+
+    //  Members of neighbouring elements are contiguous, per block of 4.
+
+    const float *p = reinterpret_cast<const float *>(a());
+    if (p[0] != 0 || p[1] != 1 || p[3] != 0 || p[4] != 0 || p[5] != 0 || p[7] != 1 || p[12] != 1 || p[12 + 4 + 3] != 2)
+        return EXIT_FAILURE;
+
+    //  As a whole.
+
+    const Vec<float> v = a(2, 4);
+    if (v.x != 2 || v.y != 4 || v.z != 8)
+        return EXIT_FAILURE;
+    a(0, 0) = Vec<float> {7, 8, 9};
+    a(1, 1) = a(0, 0);
+    const A& b = a;
+    static_assert(std::is_same_v<decltype(b(1, 1).x), const float&>);
+    if (b(1, 1).x != 7 || b(1, 1).z != 9 || b(0, 0).y != 8 || b(1, 2).y != 2)
+        return EXIT_FAILURE;
+
+    //  Row major, partial indexing.
+
+    Dynamic::Array<Vec<double>[3], Layout<aosoa>, Axis<row>> c {2, 2, 10};
+    c(1, 1, 9).y = 3;
+    c(1, 1).z = 4;
+    if (c(1, 1, 0).z != 4 || reinterpret_cast<const double *>(c())[4 * 8 * 3 + 8 + 7] != 3)
+        return EXIT_FAILURE;
+}
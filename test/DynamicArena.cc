@@ -0,0 +1,60 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+int main()
+{   using namespace Irulan;
+    using A = Dynamic::Array<double[2], Allocator<ArenaAllocator>>;
+
+    //  Bump allocation from the thread_local arena.
+
+    {   A a {2, 2}, b {2, 2};
+        if (b() != a() + 4 || &Arena::active() != &Arena::active())
+            return EXIT_FAILURE;
+        a(1, 1) = 1;
+        b(0, 0) = 2;
+        if (a()[3] != 1 || b()[0] != 2)
+            return EXIT_FAILURE;
+    }
+
+    //  Scoped arenas, reset reuses the memory.
+
+    Arena arena {1024};
+    double *first;
+    {   Arena::Scope scope {arena};
+        if (&Arena::active() != &arena)
+            return EXIT_FAILURE;
+        A a {3, 3};
+        first = a();
+        Dynamic::Array<char[1], Allocator<ArenaAllocator>, Alignment<256>> c {1};
+        Dynamic::Array<float[2], Allocator<ArenaAllocator>> big {100, 100};
+        if (reinterpret_cast<std::uintptr_t>(c()) % 256 != 0 || arena.capacity() < 1024 + 40000)
+            return EXIT_FAILURE;
+        {   Arena inner;
+            Arena::Scope scope {inner};
+            A b {1, 1};
+            if (inner.capacity() == 0)
+                return EXIT_FAILURE;
+        }
+        if (&Arena::active() != &arena)
+            return EXIT_FAILURE;
+    }
+    if (&Arena::active() == &arena)
+        return EXIT_FAILURE;
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+    {   Arena::Scope scope {arena};
+        A a {3, 3};
+        if (a() != first || arena.capacity() != capacity)
+            return EXIT_FAILURE;
+    }
+
+    //  Other threads have their own arena.
+
+    Arena *other;
+    std::thread {[&other](){ other = &Arena::active(); }}.join();
+    if (other == &Arena::active())
+        return EXIT_FAILURE;
+}
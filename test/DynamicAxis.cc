@@ -0,0 +1,56 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<float[3], Axis<row>> A {3, 4, 5};
+
+        if (A() != &A(0) || A() != &A(0, 0) || A() != &A(0, 0, 0))
+            return EXIT_FAILURE;
+
+        float *prev = A() - 1;
+        for (size_t i = 0; i < A[0]; i++)
+            for (size_t j = 0; j < A[1]; j++)
+                for (size_t k = 0; k < A[2]; k++)
+                {   if (&A(i, j, k) != prev + 1)
+                        return EXIT_FAILURE;
+                    prev = &A(i, j, k);
+                }
+
+        if (&A(1) != &A(1, 0, 0) || &A(1, 2) != &A(1, 2, 0))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Axis<row>, Layout<packed_inc>> A {4};
+        int *old = A() - 1;
+        for (size_t i = 0; i < A[0]; i++)
+            for (size_t j = 0; j <= i; j++)
+            {   if (old + 1 != &A(i, j))
+                    return EXIT_FAILURE;
+                old = &A(i, j);
+            }
+        if (&A(2) != &A(2, 0))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Axis<row>, Layout<packed_dec>> A {4};
+        int *old = A() - 1;
+        for (size_t i = 0; i < A[0]; i++)
+            for (size_t j = i; j < A[0]; j++)
+            {   if (old + 1 != &A(i, j))
+                    return EXIT_FAILURE;
+                old = &A(i, j);
+            }
+    }
+
+    {   Dynamic::Array<double[3], Axis<row>, EfficientShape<true>> A {2, 3, 4};
+        if (sizeof(A) != sizeof(double *) + 2 * sizeof(decltype(A)::size_type))
+            return EXIT_FAILURE;
+        if (A[1] != 3 || A[2] != 4)
+            return EXIT_FAILURE;
+        if (&A(1, 2, 3) != A() + 23)
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,51 @@
+#include "../include/Irulan/Batch.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+int main()
+{   using namespace Irulan;
+
+    {   Batch<Dynamic::Array<double[2]>> B {100, 3, 4};
+        if (B.count() != 100 || B.stride() != 12 || B.size() != 1200)
+            return EXIT_FAILURE;
+        for (std::size_t i = 0; i < B.size(); i++)
+            B()[i] = 0;
+        auto A = B[5];
+        A(1, 2) = 7;
+        if (A[0] != 3 || A[1] != 4 || B()[5 * 12 + 1 + 2 * 3] != 7 || B[5].copy()(1, 2) != 7)
+            return EXIT_FAILURE;
+        Batch<Dynamic::Array<double[2]>> C = std::move(B);
+        if (B() != NULL || C[5](1, 2) != 7)
+            return EXIT_FAILURE;
+        B = std::move(C);
+        if (B[5](1, 2) != 7)
+            return EXIT_FAILURE;
+    }
+
+    //  Strides are rounded up to the alignment, 10 floats to 16 bytes here, and 15 floats to 64 bytes.
+
+    {   Batch<Dynamic::Array<float[2], Layout<packed_inc>, Alignment<16>>> B {10, 4};
+        if (B.stride() != 12 || &B[3](1, 2) != B() + 36 + 4)
+            return EXIT_FAILURE;
+    }
+
+    {   Batch<Dynamic::Array<float[2], Alignment<64>>> B {10, 3, 5};
+        if (B.stride() != 16)
+            return EXIT_FAILURE;
+        for (std::size_t b = 0; b < B.count(); b++)
+            if (reinterpret_cast<std::uintptr_t>(B[b]()) % 64 != 0)
+                return EXIT_FAILURE;
+    }
+
+    {   Batch<Dynamic::Array<float[2], Axis<row>>, true> B {8, 3, 5};
+        for (std::size_t i = 0; i < B.size(); i++)
+            B()[i] = 0;
+        B[2](1, 1) = 5;
+        if (B[2][0] != 3 || B[2][1] != 5 || B()[(5 + 1) * 8 + 2] != 5 || B[1](1, 1) != 0)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Static.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+//  Whether indexing throws std::out_of_range.
+
+template <typename F>
+bool throws(F f)
+{   try
+    {   f();
+    }
+    catch (const std::out_of_range&)
+    {   return true;
+    }
+    return false;
+}
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<float[3], Checked<true>> A {4, 5, 6};
+        static_assert(!noexcept(A(0, 0, 0)) && noexcept(std::declval<Dynamic::Array<float[3]>&>()(0, 0, 0)));
+        if (sizeof A != sizeof(Dynamic::Array<float[3]>) || throws([&](){ A(3, 4, 5) = 1; }) || A(3, 4, 5) != 1 ||
+            !throws([&](){ A(4, 0, 0); }) || !throws([&](){ A(0, 5, 0); }) || !throws([&](){ A(0, 0, 6); }) ||
+            !throws([&](){ A(-1, 0, 0); }) || !throws([&](){ A(0, 6); }) || throws([&](){ A(4, 5); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Checked<true>, EfficientShape<true>, Axis<row>> A {4, 5, 6}; // the 1st dim isn't stored
+        if (!throws([&](){ A(0, 5, 0); }) || !throws([&](){ A(0, 0, 6); }) || throws([&](){ A(3, 4, 5); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[2], Checked<true>, Layout<packed_inc>> A {4};
+        if (throws([&](){ A(1, 2); }) || throws([&](){ A(3, 3); }) || !throws([&](){ A(2, 1); }) ||
+            !throws([&](){ A(1, 4); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Checked<true>, Layout<packed_dec>, Axis<row>> A {4};
+        if (throws([&](){ A(1, 2, 3); }) || !throws([&](){ A(3, 2, 1); }) || !throws([&](){ A(1); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Checked<true>, Extents<dyn, 3>> A {2};
+        if (throws([&](){ A(1, 2); }) || !throws([&](){ A(1, 3); }) || !throws([&](){ A(2, 0); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Static::Array<int[3][4], Checked<true>> A {};
+        if (throws([&](){ A(2, 3) = 1; }) || A(2, 3) != 1 || !throws([&](){ A(3, 0); }) || !throws([&](){ A(0, 4); }) ||
+            throws([&](){ A(3); }) || !throws([&](){ A(4); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Static::Array<int[3][3], Checked<true>, Layout<packed_inc>, Axis<row>> A {};
+        if (throws([&](){ A(2, 1); }) || !throws([&](){ A(1, 2); }))
+            return EXIT_FAILURE;
+    }
+
+    {   using Array = Dynamic::Array<float[2], Instrumented<true>, Alignment<4096>>;
+        Array A {8, 8};
+        for (std::size_t j = 0; j < 8; j++)
+            for (std::size_t i = 0; i < 8; i++)
+                A(i, j) = 1;
+        const AccessStatistics& a = A.statistics();
+        if (sizeof A == sizeof(Dynamic::Array<float[2]>) || a.accesses != 64 || a.strides[1] != 63 ||
+            a.same_line != 60 || a.same_page != 3 || a.far != 0)
+            return EXIT_FAILURE;
+        A.statistics().reset();
+        const Array& B = A;
+        float sum = 0;
+        for (std::size_t i = 0; i < 8; i++)
+            for (std::size_t j = 0; j < 8; j++)
+                sum += B(i, j);
+        const AccessStatistics& b = A.statistics();
+        if (sum != 64 || b.accesses != 64 || b.strides[4] != 56 || b.strides[6] != 7 || b.same_line != 32 ||
+            b.same_page != 31)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Static.h"
+#include "../include/Irulan/Convert.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+//  Values that differ per index.
+
+template <typename A>
+void fill(A& a)
+{   for (std::size_t k = 0; k < a[2]; k++)
+        for (std::size_t j = 0; j < a[1]; j++)
+            for (std::size_t i = 0; i < a[0]; i++)
+                a(i, j, k) = i + 100 * j + 10000 * k;
+}
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<double[2], Layout<packed_inc>> P {50};
+        for (std::size_t j = 0; j < 50; j++)
+            for (std::size_t i = 0; i <= j; i++)
+                P(i, j) = i + 100 * j;
+        Dynamic::Array<double[2]> C {50, 50};
+        for (auto& c : C)
+            c = -1;
+        Convert::copy(P, C);
+        for (std::size_t j = 0; j < 50; j++)
+            for (std::size_t i = 0; i < 50; i++)
+                if (C(i, j) != (i <= j ? P(i, j) : -1))
+                    return EXIT_FAILURE;
+        Dynamic::Array<double[2], Axis<row>> R {50, 50};
+        Convert::copy(P, R, true);
+        for (std::size_t j = 0; j < 50; j++)
+            for (std::size_t i = 0; i < 50; i++)
+                if (R(i, j) != P(std::min(i, j), std::max(i, j)))
+                    return EXIT_FAILURE;
+        Dynamic::Array<double[2], Layout<packed_dec>, Axis<row>> Q {50}; // the same triangle
+        Convert::copy(P, Q);
+        for (std::size_t j = 0; j < 50; j++)
+            for (std::size_t i = 0; i <= j; i++)
+                if (Q(i, j) != P(i, j))
+                    return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3]> A {30, 40, 50};
+        Dynamic::Array<float[3], Axis<row>> B {30, 40, 50};
+        Dynamic::Array<float[3], Layout<tiled>, Tile<4, 4, 4>> T {30, 40, 50};
+        Dynamic::Array<float[3], Layout<morton>> M {30, 40, 50};
+        fill(A);
+        Convert::copy(A, B);
+        Convert::copy(B, M);
+        Convert::copy(M, T);
+        for (std::size_t k = 0; k < 50; k++)
+            for (std::size_t j = 0; j < 40; j++)
+                for (std::size_t i = 0; i < 30; i++)
+                    if (B(i, j, k) != A(i, j, k) || T(i, j, k) != A(i, j, k))
+                        return EXIT_FAILURE;
+        Dynamic::Array<float[3]> E {30, 40, 51};
+        try
+        {   Convert::copy(A, E);
+            return EXIT_FAILURE;
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+
+    {   Static::Array<int[9][9][9]> S {};
+        Dynamic::Array<int[3], Layout<packed_dec>, Axis<row>> P {9};
+        fill(S);
+        Convert::copy(S, P);
+        for (std::size_t k = 0; k < 9; k++)
+            for (std::size_t j = 0; j <= k; j++)
+                for (std::size_t i = 0; i <= j; i++)
+                    if (P(i, j, k) != S(i, j, k))
+                        return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[3]> A {6, 6, 6};
+        fill(A);
+        const auto B = A.copy();
+        const int *data = A();
+        auto P = Convert::in_place<Dynamic::Array<int[3], Layout<packed_inc>>>(A);
+        if (A() != NULL || P() != data || P[0] != 6)
+            return EXIT_FAILURE;
+        for (std::size_t k = 0; k < 6; k++)
+            for (std::size_t j = 0; j <= k; j++)
+                for (std::size_t i = 0; i <= j; i++)
+                    if (P(i, j, k) != B(i, j, k))
+                        return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2]> A {70, 70};
+        for (std::size_t j = 0; j < 70; j++)
+            for (std::size_t i = 0; i < 70; i++)
+                A(i, j) = i + 100 * j;
+        const int *data = A();
+        auto R = Convert::in_place<Dynamic::Array<int[2], Axis<row>>>(A);
+        if (R() != data)
+            return EXIT_FAILURE;
+        for (std::size_t j = 0; j < 70; j++)
+            for (std::size_t i = 0; i < 70; i++)
+                if (R(i, j) != static_cast<int>(i + 100 * j))
+                    return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
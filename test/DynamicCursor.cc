@@ -0,0 +1,81 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<double[4], Layout<packed_inc>> A {5};
+        auto c = A.cursor();
+        for (std::size_t l = 0; l < A[0]; l++)
+        {   for (std::size_t k = 0; k <= l; k++)
+            {   for (std::size_t j = 0; j <= k; j++)
+                {   for (std::size_t i = 0; i <= j; i++)
+                    {   if (&*c != &A(i, j, k, l))
+                            return EXIT_FAILURE;
+                        c.next<0>();
+                    }
+                    c.reset<0>();
+                    c.next<1>();
+                }
+                c.reset<1>();
+                c.next<2>();
+            }
+            c.reset<2>();
+            c.next<3>();
+        }
+    }
+
+    {   Dynamic::Array<int[3], Layout<packed_dec>> A {6};
+        auto c = A.cursor();
+        for (std::size_t k = 0; k < A[0]; k++)
+        {   c.set<1>(k);
+            for (std::size_t j = k; j < A[0]; j++)
+            {   c.set<0>(j);
+                for (std::size_t i = j; i < A[0]; i++)
+                {   if (&*c != &A(i, j, k) || c.memory_index() != &A(i, j, k) - A())
+                        return EXIT_FAILURE;
+                    c.next<0>();
+                }
+                c.next<1>();
+            }
+            c.next<2>();
+        }
+    }
+
+    {   Dynamic::Array<int[3], Layout<packed_dec>> A {5};
+        int *prev = A() - 1;
+        for (std::size_t k = 0; k < A[0]; k++)
+            for (std::size_t j = k; j < A[0]; j++)
+                for (std::size_t i = j; i < A[0]; i++)
+                {   if (&A(i, j, k) != prev + 1)
+                        return EXIT_FAILURE;
+                    prev = &A(i, j, k);
+                }
+        if (prev + 1 != A() + A.size())
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Layout<packed_inc>, Axis<row>> A {4};
+        auto c = A.cursor();
+        c.set<0>(3);
+        c.set<1>(2);
+        c.next<2>();
+        if (&*c != &A(3, 2, 1))
+            return EXIT_FAILURE;
+        c.prev<0>();
+        c.prev<2>();
+        if (&*c != &A(2, 2, 0))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3]> A {3, 4, 5};
+        auto c = A.cursor();
+        c.next<2>();
+        c.next<2>();
+        c.next<0>();
+        c.set<1>(3);
+        if (&*c != &A(1, 3, 2) || c.get<1>() != 3)
+            return EXIT_FAILURE;
+    }
+}
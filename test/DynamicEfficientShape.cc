@@ -1,5 +1,7 @@
 #include "../include/Irulan/Dynamic.h"
 
+#include <cstdlib>
+
 int main()
 {   using namespace Irulan;
 
@@ -17,4 +19,14 @@ int main()
 
     {   Dynamic::Array<double[1], EfficientShape<true>> A;
     }
+
+    {   Dynamic::Array<double[2], EfficientShape<true>> A {3, 4};
+        double *a = A();
+        auto W = A.release();
+        if (A() != NULL || W() != a || W[0] != 3)
+            return EXIT_FAILURE;
+        auto B = decltype(A)::adopt(W);
+        if (B() != a)
+            return EXIT_FAILURE;
+    }
 }
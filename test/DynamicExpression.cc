@@ -0,0 +1,105 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Static.h"
+#include "../include/Irulan/Expression.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+//  Whether f(i, j, k) holds for all indexes of A.
+
+template <typename A, typename F>
+bool all(const A& a, F f)
+{   for (std::size_t k = 0; k < a[2]; k++)
+        for (std::size_t j = 0; j < a[1]; j++)
+            for (std::size_t i = 0; i < a[0]; i++)
+                if (!f(i, j, k))
+                    return false;
+    return true;
+}
+
+template <typename A>
+void fill(A& a, float offset)
+{   for (std::size_t k = 0; k < a[2]; k++)
+        for (std::size_t j = 0; j < a[1]; j++)
+            for (std::size_t i = 0; i < a[0]; i++)
+                a(i, j, k) = offset + i + 10 * j + 100 * k;
+}
+
+int main()
+{   using namespace Irulan;
+    using Expression::assign;
+
+    Dynamic::Array<float[3], Instrumented<true>> A {4, 5, 6};
+    Dynamic::Array<float[3]> B {4, 5, 6}, C {4, 5, 6};
+    fill(A, 0);
+    fill(B, 1000);
+    A.statistics().reset();
+
+    {   assign(C, A + B * 2.f);
+        if (A.statistics().accesses != 0 || !all(C, [&](auto i, auto j, auto k){ return C(i, j, k) == A(i, j, k) + 2 * B(i, j, k); }))
+            return EXIT_FAILURE;
+        assign(C, -(C - A) / 2 + 1); // reads C where it's written
+        if (!all(C, [&](auto i, auto j, auto k){ return C(i, j, k) == 1 - B(i, j, k); }))
+            return EXIT_FAILURE;
+        assign(C, Expression::map([](float a, float b){ return a > b ? a : b; }, A, 3 * B - 4000));
+        if (!all(C, [&](auto i, auto j, auto k){ return C(i, j, k) == std::max(A(i, j, k), 3 * B(i, j, k) - 4000); }))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Axis<row>> R {4, 5, 6};
+        Static::Array<float[4][5][6]> S {};
+        fill(R, 2000);
+        fill(S, 3000);
+        A.statistics().reset();
+        assign(C, R + S - A);
+        if (A.statistics().accesses != A.size() ||
+            !all(C, [&](auto i, auto j, auto k){ return C(i, j, k) == R(i, j, k) + S(i, j, k) - A(i, j, k); }))
+            return EXIT_FAILURE;
+    }
+
+    //  Only trees of the operators are vectorized, functions given to map are called in memory order.
+
+    {   float count = 0;
+        const auto e = Expression::map([&count](float a){ return a * 0 + count++; }, A) + B;
+        static_assert(decltype(-A + B * 2.f)::builtin && !decltype(e)::builtin);
+        assign(C, e);
+        for (std::size_t k = 0; k < C.size(); k++)
+            if (C()[k] != k + B()[k])
+                return EXIT_FAILURE;
+    }
+
+    {   assign(C, 0.f);
+        const auto V = C.view(View::Range {1, 4}, View::all, 2);
+        assign(V, A.view(View::Range {0, 3}, View::all, 3) * 2);
+        if (C(0, 0, 2) != 0 || C(1, 0, 2) != 2 * A(0, 0, 3) || C(3, 4, 2) != 2 * A(2, 4, 3) || C(3, 4, 3) != 0)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[2], Layout<packed_inc>> P {5}, Q {5};
+        Dynamic::Array<float[2]> D {5, 5};
+        for (std::size_t j = 0; j < 5; j++)
+            for (std::size_t i = 0; i < 5; i++)
+            {   D(i, j) = i + 10 * j;
+                if (i <= j)
+                    P(i, j) = 1;
+            }
+        assign(Q, P + D);
+        for (std::size_t j = 0; j < 5; j++)
+            for (std::size_t i = 0; i <= j; i++)
+                if (Q(i, j) != 1 + D(i, j))
+                    return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3]> E {4, 5, 7};
+        try
+        {   assign(C, A + E);
+            return EXIT_FAILURE;
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/File.h"
+#include "../include/Irulan/Mapping.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+//  Same memory index as without Extents.
+
+template <typename A, typename B>
+bool same(A& a, B& b)
+{   for (std::size_t i = 0; i < a[0]; i++)
+        for (std::size_t j = 0; j < a[1]; j++)
+            for (std::size_t k = 0; k < a[2]; k++)
+                if (&a(i, j, k) - a() != &b(i, j, k) - b())
+                    return false;
+    return true;
+}
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<float[3], Extents<dyn, dyn, 3>> A {40, 30}; // only the dynamic dims
+        Dynamic::Array<float[3]> B {40, 30, 3};
+        if (sizeof A != sizeof(float *) + 2 * sizeof(std::size_t) || A[0] != 40 || A[1] != 30 || A[2] != 3 ||
+            A.size() != B.size() || !same(A, B))
+            return EXIT_FAILURE;
+        Dynamic::Array<float[3], Extents<dyn, dyn, 3>> C {40, 30, 3}; // or all of them
+        if (C[0] != 40 || C[1] != 30 || C[2] != 3 || decltype(C)::data_size(40, 30) != 3600)
+            return EXIT_FAILURE;
+        A = std::move(C);
+        const auto D = A.copy();
+        if (D[1] != 30 || D.size() != 3600)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[3], Extents<4, dyn, 2>, Axis<row>> A {5};
+        Dynamic::Array<int[3], Axis<row>> B {4, 5, 2};
+        if (sizeof A != sizeof(int *) + sizeof(std::size_t) || A[0] != 4 || A[1] != 5 || !same(A, B))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[3], Extents<8, 8, 8>> A {};
+        if (sizeof A != sizeof(int *) || A.size() != 512 || &A(7, 7, 7) - A() != 511)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[3], Extents<dyn, 3, dyn>, Layout<tiled>, Tile<4, 2, 2>> A {9, 5};
+        Dynamic::Array<int[3], Layout<tiled>, Tile<4, 2, 2>> B {9, 3, 5};
+        Dynamic::Array<int[3], Extents<dyn, 3, dyn>, Layout<morton>> C {9, 5};
+        Dynamic::Array<int[3], Layout<morton>> D {9, 3, 5};
+        if (A.size() != B.size() || !same(A, B) || C.size() != D.size() || !same(C, D))
+            return EXIT_FAILURE;
+    }
+
+    //  Files store all dims.
+
+    {   using A = Dynamic::Array<double[2], Extents<dyn, 2>>;
+        File::Writer<A> W {"DynamicExtents.irl", 3};
+        const double data[6] {1, 2, 3, 4, 5, 6};
+        W.write(data, 6);
+        W.close();
+        const auto B = File::load<Dynamic::Array<double[2]>>("DynamicExtents.irl");
+        const auto C = File::load<A>("DynamicExtents.irl");
+        if (B[0] != 3 || B[1] != 2 || B(2, 1) != 6 || C[0] != 3 || C(2, 1) != 6)
+            return EXIT_FAILURE;
+        //  Fixed dims must match the file.
+        try
+        {   File::load<Dynamic::Array<double[2], Extents<dyn, 3>>>("DynamicExtents.irl");
+            return EXIT_FAILURE;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        try
+        {   Mapping<Dynamic::Array<double[2], Extents<dyn, 3>>>::open("DynamicExtents.irl");
+            return EXIT_FAILURE;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        std::remove("DynamicExtents.irl");
+    }
+}
@@ -0,0 +1,130 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/File.h"
+#include "../include/Irulan/Mapping.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+int main()
+{   using namespace Irulan;
+    const char *path = "DynamicFile.irl";
+
+    //  Streaming in chunks.
+
+    {   File::Writer<Dynamic::Array<float[3], Axis<row>>> W {path, 4, 5, 6};
+        float chunk[30];
+        for (int c = 0; c < 4; c++)
+        {   for (int i = 0; i < 30; i++)
+                chunk[i] = c * 30 + i;
+            W.write(chunk, 30);
+        }
+        try
+        {   W.write(chunk, 1);
+            return EXIT_FAILURE;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        W.close();
+    }
+
+    {   const auto A = File::load<Dynamic::Array<float[3], Axis<row>>>(path);
+        if (A[0] != 4 || A[1] != 5 || A[2] != 6 || A(1, 2, 3) != 30 + 12 + 3)
+            return EXIT_FAILURE;
+        const auto B = File::load<Dynamic::Array<float[3], Axis<row>, SizeType<std::uint8_t>, EfficientShape<true>>>(path);
+        if (B(3, 4, 5) != 119)
+            return EXIT_FAILURE;
+        auto M = Mapping<Dynamic::Array<float[3], Axis<row>>>::open(path);
+        if (M(1, 2, 3) != 45)
+            return EXIT_FAILURE;
+    }
+
+    //  Properties that change the data must match.
+
+    auto fails = [path](auto load)
+        {   try
+            {   load(path);
+                return false;
+            }
+            catch (const std::runtime_error&)
+            {   return true;
+            }
+        };
+    if (!fails(File::load<Dynamic::Array<float[3]>>) ||
+        !fails(File::load<Dynamic::Array<std::int32_t[3], Axis<row>>>) ||
+        !fails(File::load<Dynamic::Array<float[3], Axis<row>, Layout<morton>>>) ||
+        !fails(File::load<Dynamic::Array<float[2], Axis<row>>>) ||
+        !fails(File::load<Dynamic::Array<float[3], Axis<row>, Layout<tiled>, Tile<2, 2, 2>>>))
+        return EXIT_FAILURE;
+
+    //  Saving whole arrays.
+
+    {   Dynamic::Array<double[3], Layout<packed_dec>> A {5};
+        for (std::size_t i = 0; i < A.size(); i++)
+            A()[i] = i;
+        File::save(path, A);
+        const auto B = File::load<Dynamic::Array<double[3], Layout<packed_dec>>>(path);
+        if (B.size() != A.size() || B(4, 3, 2) != A(4, 3, 2) || B(1, 1, 1) != A(1, 1, 1))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Layout<tiled>, Tile<4, 2>> A {5, 3};
+        for (std::size_t i = 0; i < 5; i++)
+            for (std::size_t j = 0; j < 3; j++)
+                A(i, j) = 10 * i + j;
+        File::save(path, A);
+        if (!fails(File::load<Dynamic::Array<int[2], Layout<tiled>, Tile<2, 4>>>))
+            return EXIT_FAILURE;
+        const auto B = File::load<Dynamic::Array<int[2], Layout<tiled>, Tile<4, 2>>>(path);
+        if (B[0] != 5 || B[1] != 3 || B(4, 2) != 42 || B(2, 1) != 21)
+            return EXIT_FAILURE;
+    }
+
+    {   File::Writer<Dynamic::Array<int[1]>> W {path, 10};
+        int a[5] {};
+        W.write(a, 5);
+        try
+        {   W.close();
+            return EXIT_FAILURE;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+
+    //  An order that doesn't fit the header is rejected before anything is allocated for it.
+
+    {   std::vector<char> bytes(File::header_size(1));
+        File::write_header(bytes.data(), File::make_header<Dynamic::Array<int[1]>>(10));
+        const std::uint32_t order = 0xffffffff;
+        std::memcpy(bytes.data() + sizeof File::magic + sizeof File::version, &order, sizeof order);
+        try
+        {   File::read_header(bytes.data(), bytes.size());
+            return EXIT_FAILURE;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+        std::ofstream {path, std::ios::binary}.write(bytes.data(), bytes.size());
+        if (!fails(File::load<Dynamic::Array<int[1]>>))
+            return EXIT_FAILURE;
+    }
+
+    //  Dims whose data size doesn't fit a std::size_t are rejected, instead of wrapping around to a small size.
+
+    {   File::Header header = File::make_header<Dynamic::Array<int[2]>>(1, 1);
+        header.dims = {std::uint64_t {1} << 32, std::uint64_t {1} << 32};
+        std::vector<char> bytes(header.data_offset + 64);
+        File::write_header(bytes.data(), header);
+        std::ofstream {path, std::ios::binary}.write(bytes.data(), bytes.size());
+        if (!fails(File::load<Dynamic::Array<int[2]>>) ||
+            !fails([](const char *p){ return Mapping<Dynamic::Array<int[2]>>::open(p); }))
+            return EXIT_FAILURE;
+    }
+
+    std::remove(path);
+}
@@ -0,0 +1,99 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+#include <utility>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<double[2], Growable<true>> A {3, 0};
+        std::size_t moves = 0;
+        const double *data = A();
+        for (std::size_t j = 0; j < 1000; j++)
+        {   double *slice = A.append_slice();
+            for (std::size_t i = 0; i < 3; i++)
+                slice[i] = i + 10 * j;
+            if (A() != data)
+            {   moves++;
+                data = A();
+            }
+        }
+        if (A[0] != 3 || A[1] != 1000 || A.size() != 3000 || A.capacity() < 3000 || moves > 12)
+            return EXIT_FAILURE;
+        for (std::size_t j = 0; j < 1000; j++)
+            for (std::size_t i = 0; i < 3; i++)
+                if (A(i, j) != i + 10 * j)
+                    return EXIT_FAILURE;
+        A.append_slice(&A(0, 7)); // a slice of itself
+        if (A[1] != 1001 || A(2, 1000) != 72)
+            return EXIT_FAILURE;
+
+        const std::size_t capacity = A.capacity();
+        A.resize(10);
+        if (A[1] != 10 || A.capacity() != capacity || A(2, 9) != 92)
+            return EXIT_FAILURE;
+        const auto B = A.copy();
+        if (B.capacity() != 30 || B(2, 9) != 92)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[3], Axis<row>, Growable<true>> R {0, 4, 5};
+        R.reserve(100);
+        const int *data = R();
+        for (int k = 0; k < 100; k++)
+        {   int *slice = R.append_slice();
+            for (int i = 0; i < 20; i++)
+                slice[i] = k;
+        }
+        if (R() != data || R[0] != 100 || R.capacity() != 2000 || R(99, 3, 4) != 99 || R(50, 0, 0) != 50)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[2], Growable<true>, InlineCapacity<8>, Extents<2, dyn>> A {1};
+        const float *data = A();
+        A(0, 0) = 1;
+        A(1, 0) = 2;
+        A.append_slice(A());
+        A.append_slice(A());
+        A.append_slice(A());
+        if (A() != data || A.capacity() != 8 || A(1, 3) != 2)
+            return EXIT_FAILURE;
+        A.append_slice(A());
+        if (A() == data || A[1] != 5 || A(0, 4) != 1 || A(1, 4) != 2 || A(1, 2) != 2)
+            return EXIT_FAILURE;
+    }
+
+    //  A moved from array is empty, and can grow again.
+
+    {   Dynamic::Array<int[2], Growable<true>> A {3, 0};
+        A.reserve(8);
+        auto B = std::move(A);
+        A.append_slice()[0] = 1;
+        if (A() == NULL || A[1] != 1 || A(0, 0) != 1 || B.capacity() != 24 || B[1] != 0)
+            return EXIT_FAILURE;
+        B.append_slice()[2] = 2;
+        A = std::move(B);
+        if (B[1] != 0 || B.capacity() != 0 || A[1] != 1 || A(2, 0) != 2)
+            return EXIT_FAILURE;
+        B.append_slice()[1] = 3;
+        if (B[1] != 1 || B(1, 0) != 3)
+            return EXIT_FAILURE;
+    }
+
+    //  So is a released one.
+
+    {   Dynamic::Array<double[2], Growable<true>> A {3, 4};
+        A(2, 3) = 5;
+        auto W = A.release();
+        if (A() != NULL || A[1] != 0 || A.capacity() != 0 || W[1] != 4 || W(2, 3) != 5)
+            return EXIT_FAILURE;
+        A.append_slice()[0] = 6;
+        if (A[1] != 1 || A(0, 0) != 6)
+            return EXIT_FAILURE;
+        auto B = decltype(A)::adopt(W);
+        if (B(2, 3) != 5)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
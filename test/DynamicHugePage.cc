@@ -0,0 +1,41 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/HugePage.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+    using Array = Dynamic::Array<double[2], Allocator<HugePageAllocator>>;
+
+    {   Array A {1024, 512}; // 4 MiB
+        const Pages pages = HugePages::pages(A());
+        if (pages.size < 4096 || (pages.size & (pages.size - 1)) != 0 ||
+            reinterpret_cast<std::uintptr_t>(A()) % pages.size != 0)
+            return EXIT_FAILURE;
+        for (std::size_t i = 0; i < A.size(); i++)
+            A()[i] = i;
+        auto B = A.copy();
+        if (B(1023, 511) != A.size() - 1 || HugePages::pages(B()).size != pages.size)
+            return EXIT_FAILURE;
+        const double *data = A();
+        A = std::move(B);
+        if (HugePages::pages(data).size != 0) // given back
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[1], Allocator<HugePageAllocator>, Alignment<1 << 14>> A {10}; // small, on normal pages
+        const Pages pages = HugePages::pages(A());
+        if (pages.transparent || pages.size >= 1 << 21 || reinterpret_cast<std::uintptr_t>(A()) % (1 << 14) != 0)
+            return EXIT_FAILURE;
+        A(9) = 1;
+    }
+
+    {   int x;
+        if (HugePages::pages(&x).size != 0)
+            return EXIT_FAILURE;
+        HugePages::deallocate(NULL);
+    }
+
+    return EXIT_SUCCESS;
+}
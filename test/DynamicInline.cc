@@ -0,0 +1,70 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+static std::size_t allocations = 0;
+
+template <typename T, std::size_t alignment>
+struct Counting
+{   static T *allocate(std::size_t n)
+    {   allocations++;
+        return Irulan::HeapAllocator<T, alignment>::allocate(n);
+    }
+
+    static void deallocate(T *p) noexcept
+    {   Irulan::HeapAllocator<T, alignment>::deallocate(p);
+    }
+};
+
+int main()
+{   using namespace Irulan;
+    using A = Dynamic::Array<double[2], InlineCapacity<16>, Allocator<Counting>>;
+
+    //  No cost without it, wrappers have no buffer.
+
+    if (sizeof(Dynamic::Array<double[2]>) != sizeof(double *) + 2 * sizeof(std::size_t) ||
+        sizeof(A::wrapper_type) != sizeof(Dynamic::Array<double[2]>) || sizeof(A) < 16 * sizeof(double))
+        return EXIT_FAILURE;
+
+    {   A a {3, 3}, b {4, 4}, c {5, 5};
+        if (allocations != 1)
+            return EXIT_FAILURE;
+        const char *object = reinterpret_cast<const char *>(&a);
+        const char *data = reinterpret_cast<const char *>(a());
+        if (data < object || data >= object + sizeof a || reinterpret_cast<std::uintptr_t>(a()) % 16 != 0)
+            return EXIT_FAILURE;
+        a(2, 2) = 1;
+        b(3, 3) = 2;
+        c(4, 4) = 3;
+
+        A d {std::move(a)};
+        if (d() == a() || a() != NULL || d(2, 2) != 1 ||
+            reinterpret_cast<const char *>(d()) < reinterpret_cast<const char *>(&d))
+            return EXIT_FAILURE;
+        A e {std::move(c)};
+        if (e(4, 4) != 3 || allocations != 1)
+            return EXIT_FAILURE;
+        e = std::move(b);
+        if (e(3, 3) != 2 || e() == b() || e[0] != 4)
+            return EXIT_FAILURE;
+
+        const auto f = d.copy();
+        if (f() == d() || f(2, 2) != 1 || allocations != 1)
+            return EXIT_FAILURE;
+
+        auto w = d.release();
+        if (allocations != 2 || w(2, 2) != 1 || d() != NULL)
+            return EXIT_FAILURE;
+        A g = A::adopt(w);
+        if (g() != w())
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Layout<packed_inc>, InlineCapacity<10>> h {3};
+        h(2, 2, 2) = 1;
+        if (h()[9] != 1 || reinterpret_cast<const char *>(h()) >= reinterpret_cast<const char *>(&h) + sizeof h)
+            return EXIT_FAILURE;
+    }
+}
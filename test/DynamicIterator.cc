@@ -0,0 +1,72 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<int[3]> A {3, 4, 5};
+        std::iota(A.begin(), A.end(), 0);
+        if (A.end() - A.begin() != 60 || A(2, 3, 4) != 59)
+            return EXIT_FAILURE;
+
+        const auto& B = A;
+        if (std::accumulate(B.begin(), B.end(), 0) != 59 * 60 / 2)
+            return EXIT_FAILURE;
+
+        std::size_t n = 0;
+        for (auto [index, value] : A.indexed())
+        {   if (&value != &A(index[0], index[1], index[2]))
+                return EXIT_FAILURE;
+            n++;
+        }
+        if (n != 60)
+            return EXIT_FAILURE;
+        using Iterator = decltype(A.indexed().begin());
+        static_assert(std::is_same_v<std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag>);
+    }
+
+    {   Dynamic::Array<int[3], Layout<packed_inc>> A {4};
+        std::size_t n = 0;
+        for (auto [index, value] : A.indexed())
+        {   if (index[0] > index[1] || index[1] > index[2] || &value != &A(index[0], index[1], index[2]))
+                return EXIT_FAILURE;
+            n++;
+        }
+        if (n != A.size())
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Layout<packed_dec>> A {4};
+        std::size_t n = 0;
+        for (auto [index, value] : A.indexed())
+        {   if (index[0] < index[1] || &value != &A(index[0], index[1]))
+                return EXIT_FAILURE;
+            n++;
+        }
+        if (n != A.size())
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Layout<packed_inc>, Axis<row>> A {5};
+        std::size_t n = 0;
+        for (auto [index, value] : A.indexed())
+        {   if (index[1] > index[0] || &value != &A(index[0], index[1]))
+                return EXIT_FAILURE;
+            n++;
+        }
+        if (n != A.size())
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Axis<row>> A {3, 2};
+        const auto& B = A;
+        auto range = B.indexed();
+        if (std::count_if(range.begin(), range.end(), [](auto e){ return e.index[1] == 1; }) != 3)
+            return EXIT_FAILURE;
+    }
+}
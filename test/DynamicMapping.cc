@@ -0,0 +1,61 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Mapping.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+
+int main()
+{   using namespace Irulan;
+    const char *path = "DynamicMapping.irl";
+
+    {   auto M = Mapping<Dynamic::Array<float[3]>>::create(path, 3, 4, 5);
+        if (M[0] != 3 || M[1] != 4 || M[2] != 5 || reinterpret_cast<std::uintptr_t>(M()) % 4096 != 0)
+            return EXIT_FAILURE;
+        for (std::size_t i = 0; i < M.size(); i++)
+            M()[i] = i;
+        M.sync();
+    }
+
+    {   auto M = Mapping<Dynamic::Array<const float[3]>>::open(path, Advice::sequential);
+        static_assert(std::is_same_v<std::decay_t<decltype(M())>, const float *>);
+        static_assert(std::is_same_v<decltype(M(2, 3, 4)), const float&>);
+        if (M[0] != 3 || M[1] != 4 || M[2] != 5 || M(2, 3, 4) != 59)
+            return EXIT_FAILURE;
+    }
+
+    {   auto M = Mapping<Dynamic::Array<float[3]>>::open(path, Advice::random);
+        M(0, 0, 0) = -1;
+    }
+
+    {   const auto M = Mapping<Dynamic::Array<float[3], EfficientShape<true>>>::open(path);
+        if (M(0, 0, 0) != -1 || M(1, 0, 0) != 1)
+            return EXIT_FAILURE;
+    }
+
+    try
+    {   auto M = Mapping<Dynamic::Array<double[3]>>::open(path);
+        return EXIT_FAILURE;
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    try
+    {   auto M = Mapping<Dynamic::Array<float[3]>>::open("DynamicMapping.missing");
+        return EXIT_FAILURE;
+    }
+    catch (const std::system_error&)
+    {
+    }
+
+    {   auto M = Mapping<Dynamic::Array<double[2], Layout<packed_inc>>>::create(path, 100);
+        M(99, 99) = 1;
+        auto N = std::move(M);
+        if (N(99, 99) != 1 || N.size() != 5050)
+            return EXIT_FAILURE;
+    }
+
+    std::remove(path);
+}
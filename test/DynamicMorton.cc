@@ -0,0 +1,35 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+#include <vector>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<int[2], Layout<morton>> A {4, 3};
+        if (A.size() != 16)
+            return EXIT_FAILURE;
+        //  The Z in the 1st 2 by 2 block, then the next block along the 1st dim.
+        if (&A(0, 0) != A() || &A(1, 0) != A() + 1 || &A(0, 1) != A() + 2 || &A(1, 1) != A() + 3 ||
+            &A(2, 0) != A() + 4 || &A(0, 2) != A() + 8 || &A(3, 3) != A() + 15)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Layout<morton>> A {5, 6, 7};
+        if (A.size() != 8 * 8 * 8)
+            return EXIT_FAILURE;
+        if (&A(1, 0, 0) != A() + 1 || &A(0, 1, 0) != A() + 2 || &A(0, 0, 1) != A() + 4 || &A(7, 7, 7) != A() + 511)
+            return EXIT_FAILURE;
+        std::vector<int> seen(A.size());
+        for (std::size_t k = 0; k < A[2]; k++)
+            for (std::size_t j = 0; j < A[1]; j++)
+                for (std::size_t i = 0; i < A[0]; i++)
+                    if (seen[&A(i, j, k) - A()]++)
+                        return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<char[4], Layout<morton>, Axis<row>> A {2, 2, 2, 2};
+        if (&A(0, 0, 0, 1) != A() + 1 || &A(1, 0, 0, 0) != A() + 8)
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,114 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Npy.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+int main()
+{   using namespace Irulan;
+    const char *path = "DynamicNpy.npy";
+
+    //  A file as written by numpy.save(path, numpy.arange(6, dtype='<i4').reshape(2, 3)).
+
+    {   std::string dict = "{'descr': '<i4', 'fortran_order': False, 'shape': (2, 3), }";
+        dict.resize(128 - 10 - 1, ' ');
+        std::ofstream file {path, std::ios::binary};
+        file.write("\x93NUMPY\x01\x00\x76\x00", 10);
+        file << dict << '\n';
+        for (std::int32_t i = 0; i < 6; i++)
+            file.write(reinterpret_cast<const char *>(&i), sizeof i);
+    }
+
+    {   const auto A = Npy::load<Dynamic::Array<std::int32_t[2], Axis<row>>>(path);
+        if (A[0] != 2 || A[1] != 3 || A(0, 2) != 2 || A(1, 0) != 3 || A()[5] != 5)
+            return EXIT_FAILURE;
+        const auto B = Npy::load<Dynamic::Array<std::int32_t[2]>>(path); // transposed
+        if (B[0] != 2 || B[1] != 3 || B(0, 2) != 2 || B(1, 0) != 3 || B()[1] != 3)
+            return EXIT_FAILURE;
+        const auto M = Npy::open<Dynamic::Array<std::int32_t[2], Axis<row>>>(path);
+        if (M(1, 2) != 5)
+            return EXIT_FAILURE;
+    }
+
+    //  Mismatches.
+
+    auto fails = [path](auto f)
+        {   try
+            {   f(path);
+                return false;
+            }
+            catch (const std::runtime_error&)
+            {   return true;
+            }
+        };
+    if (!fails(Npy::load<Dynamic::Array<float[2], Axis<row>>>) ||
+        !fails(Npy::load<Dynamic::Array<std::int32_t[3], Axis<row>>>) ||
+        !fails([](const char *p){ return Npy::open<Dynamic::Array<std::int32_t[2]>>(p); }))
+        return EXIT_FAILURE;
+
+    //  Malformed headers.
+
+    auto invalid = [](std::string dict)
+        {   dict.resize(64 - 10 - 1, ' ');
+            const std::string bytes = std::string {"\x93NUMPY\x01\x00\x36\x00", 10} + dict + '\n';
+            try
+            {   Npy::read_header(bytes.data(), bytes.size());
+                return false;
+            }
+            catch (const std::runtime_error&)
+            {   return true;
+            }
+        };
+    if (!invalid("{'descr': '<i4', 'fortran_order': False, 'shape': (-1, 3), }") ||
+        !invalid("{'descr': '<i4', 'fortran_order': False, 'shape': (99999999999999999999,), }") ||
+        !invalid("{'descr': '<i4', 'fortran_order': False, 'shape': (x,), }") ||
+        !invalid("{'descr': '<i4', 'fortran_order': False, 'shape':"))
+        return EXIT_FAILURE;
+
+    //  A shape whose data size overflows.
+
+    {   std::string dict = "{'descr': '<i4', 'fortran_order': False, 'shape': (4294967296, 4294967296), }";
+        dict.resize(128 - 10 - 1, ' ');
+        std::ofstream file {path, std::ios::binary};
+        file.write("\x93NUMPY\x01\x00\x76\x00", 10);
+        file << dict << '\n';
+        file.write("\0\0\0\0", 4);
+    }
+    if (!fails(Npy::load<Dynamic::Array<std::int32_t[2], Axis<row>>>) ||
+        !fails([](const char *p){ return Npy::open<Dynamic::Array<std::int32_t[2], Axis<row>>>(p); }))
+        return EXIT_FAILURE;
+
+    //  Round trips, column major is fortran_order.
+
+    {   Dynamic::Array<double[3]> A {4, 3, 2};
+        for (std::size_t i = 0; i < A.size(); i++)
+            A()[i] = i;
+        Npy::save(path, A);
+        std::ifstream file {path, std::ios::binary};
+        std::string start(128, '\0');
+        file.read(&start[0], start.size());
+        if (start.find("'descr': '<f8', 'fortran_order': True, 'shape': (4, 3, 2), }") == std::string::npos ||
+            start.find('\n') % 64 != 63)
+            return EXIT_FAILURE;
+        const auto B = Npy::load<Dynamic::Array<double[3]>>(path);
+        const auto C = Npy::load<Dynamic::Array<double[3], Axis<row>>>(path);
+        if (B(3, 2, 1) != A(3, 2, 1) || C(3, 2, 1) != A(3, 2, 1) || C(1, 2, 0) != A(1, 2, 0))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<std::uint8_t[1]> A {5};
+        A(4) = 7;
+        Npy::save(path, A);
+        auto M = Npy::open<Dynamic::Array<std::uint8_t[1]>>(path);
+        if (M[0] != 5 || M(4) != 7)
+            return EXIT_FAILURE;
+        const auto N = Npy::open<Dynamic::Array<const std::uint8_t[1]>>(path);
+        if (N[0] != 5 || N(4) != 7)
+            return EXIT_FAILURE;
+    }
+
+    std::remove(path);
+}
@@ -1,5 +1,7 @@
 #include "../include/Irulan/Dynamic.h"
 
+#include <cstdlib>
+
 int main()
 {   using namespace Irulan;
 
@@ -0,0 +1,69 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+
+using namespace Irulan;
+
+Dynamic::Array<float[2]> make(std::size_t m, std::size_t n)
+{   Dynamic::Array<float[2]> A {m, n};
+    A(m - 1, n - 1) = 42;
+    return A;
+}
+
+static_assert(!std::is_copy_constructible_v<Dynamic::Array<float[2]>>);
+static_assert(!std::is_copy_assignable_v<Dynamic::Array<float[2]>>);
+static_assert(std::is_nothrow_move_constructible_v<Dynamic::Array<float[2]>>);
+static_assert(std::is_copy_constructible_v<Dynamic::Array<float[2], Allocate<false>>>);
+static_assert(std::is_copy_assignable_v<Dynamic::Array<float[2], Allocate<false>>>);
+
+int main()
+{
+    {   auto A = make(3, 4);
+        if (A[0] != 3 || A[1] != 4 || A(2, 3) != 42)
+            return EXIT_FAILURE;
+
+        float *a = A();
+        Dynamic::Array<float[2]> B {std::move(A)};
+        if (B() != a || A() != NULL || B[0] != 3 || B[1] != 4)
+            return EXIT_FAILURE;
+
+        Dynamic::Array<float[2]> C {1, 1};
+        C = std::move(B);
+        if (C() != a || B() != NULL || C(2, 3) != 42)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Layout<packed_inc>> A {4};
+        for (std::size_t i = 0; i < A.size(); i++)
+            A()[i] = i;
+        auto B = A.copy();
+        if (B() == A() || B[0] != 4 || B.size() != 10)
+            return EXIT_FAILURE;
+        for (std::size_t i = 0; i < B.size(); i++)
+            if (B()[i] != A()[i])
+                return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<double[3]> A {2, 3, 4};
+        double *a = A();
+        auto W = A.release();
+        if (A() != NULL || W() != a || W[0] != 2 || W[1] != 3 || W[2] != 4)
+            return EXIT_FAILURE;
+        auto V = W;
+        if (V() != a)
+            return EXIT_FAILURE;
+        auto B = decltype(A)::adopt(W);
+        if (B() != a || B[2] != 4)
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<double[2], Allocate<false>> W {2, 2};
+        double w[4] {1, 2, 3, 4};
+        W() = w;
+        auto A = W.copy();
+        if (A() == w || A(1, 1) != 4)
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,61 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Parallel.h"
+
+#include <cstdlib>
+#include <functional>
+
+//  Every element must be visited once, with its own indexes.
+
+template <typename Array>
+bool check(Array& A)
+{   using namespace Irulan;
+    Parallel::fill(A, 0);
+    Parallel::for_each(A, [](auto& value){ value += 1; });
+    if (Parallel::reduce(A, std::size_t {0}, std::plus<> {}) != A.size())
+        return false;
+    Parallel::for_each(A, [&A](auto& value, auto... i){ value = &A(i...) - A(); });
+    for (std::size_t k = 0; k < A.size(); k++)
+        if (A()[k] != static_cast<typename Array::value_type>(k))
+            return false;
+    return true;
+}
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<long[3]> A {7, 5, 3};
+        Dynamic::Array<long[3], Axis<row>> B {7, 5, 3};
+        Dynamic::Array<long[3], Layout<packed_inc>> C {9};
+        Dynamic::Array<long[3], Layout<packed_dec>> D {9};
+        Dynamic::Array<long[4], Layout<packed_dec>, Axis<row>> E {6};
+        Dynamic::Array<long[2], Layout<packed_inc>, Axis<row>, EfficientShape<true>> F {100};
+        Dynamic::Array<long[1]> G {1000};
+        if (!check(A) || !check(B) || !check(C) || !check(D) || !check(E) || !check(F) || !check(G))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<long[3], Layout<tiled>, Tile<4, 2, 2>> A {7, 5, 3};
+        Dynamic::Array<long[2], Layout<morton>, Axis<row>> B {5, 7};
+        Parallel::fill(A, [](auto i, auto j, auto k){ return 100 * i + 10 * j + k; });
+        Parallel::fill(B, [](auto i, auto j){ return 10 * i + j; });
+        for (long i = 0; i < 7; i++)
+            for (long j = 0; j < 5; j++)
+                if (A(i, j, 2) != 100 * i + 10 * j + 2 || B(j, i) != 10 * j + i)
+                    return EXIT_FAILURE;
+        if (Parallel::reduce(B, 0l, std::plus<> {}) != 7 * (0 + 10 + 20 + 30 + 40) + 5 * (0 + 1 + 2 + 3 + 4 + 5 + 6))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<double[2], Layout<packed_inc>> A {50};
+        Dynamic::Array<float[2], Layout<packed_inc>> B {50};
+        Parallel::fill(A, 2.0);
+        Parallel::transform(A, B, [](double a, std::size_t i, std::size_t j){ return a * i + j; });
+        if (B(3, 7) != 2 * 3 + 7 || B(49, 49) != 2 * 49 + 49)
+            return EXIT_FAILURE;
+        const double max = Parallel::reduce(B, 0.0, [](double a, double b){ return a > b ? a : b; });
+        const double diagonal = Parallel::reduce(A, 0.0, std::plus<> {},
+            [](double a, std::size_t i, std::size_t j){ return i == j ? a : 0; });
+        if (max != 147 || diagonal != 100)
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,73 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Static.h"
+#include "../include/Irulan/Convert.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+template <typename A>
+void fill(A& a)
+{   for (std::size_t k = 0; k < a[2]; k++)
+        for (std::size_t j = 0; j < a[1]; j++)
+            for (std::size_t i = 0; i < a[0]; i++)
+                a(i, j, k) = i + 100 * j + 10000 * k;
+}
+
+int main()
+{   using namespace Irulan;
+
+    Dynamic::Array<float[3]> A {33, 17, 20};
+    fill(A);
+
+    {   Dynamic::Array<float[3]> B {20, 33, 17};
+        Convert::permute<2, 0, 1>(A, B);
+        for (std::size_t k = 0; k < 20; k++)
+            for (std::size_t j = 0; j < 17; j++)
+                for (std::size_t i = 0; i < 33; i++)
+                    if (B(k, i, j) != A(i, j, k))
+                        return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<float[3], Axis<row>> B {33, 20, 17};
+        Convert::permute<0, 2, 1>(A, B);
+        for (std::size_t k = 0; k < 20; k++)
+            for (std::size_t j = 0; j < 17; j++)
+                for (std::size_t i = 0; i < 33; i++)
+                    if (B(i, k, j) != A(i, j, k))
+                        return EXIT_FAILURE;
+        Dynamic::Array<float[3]> C {33, 20, 17};
+        Convert::permute<0, 1, 2>(B, C); // the fastest dims differ as B is row major
+        for (std::size_t k = 0; k < 20; k++)
+            for (std::size_t j = 0; j < 17; j++)
+                for (std::size_t i = 0; i < 33; i++)
+                    if (C(i, k, j) != A(i, j, k))
+                        return EXIT_FAILURE;
+    }
+
+    {   Static::Array<int[40][50][1]> S {};
+        Dynamic::Array<int[3]> C {60, 60, 3};
+        fill(S);
+        for (auto& c : C)
+            c = 0;
+        auto V = C.view(View::Range {5, 55}, View::Range {10, 50}, 1);
+        Convert::permute(S.view(View::all, View::all, 0), V, {1, 0});
+        if (C(5, 10, 1) != 0 || C(54, 49, 1) != S(39, 49, 0) || C(7, 13, 1) != S(3, 2, 0) || C(7, 13, 0) != 0)
+            return EXIT_FAILURE;
+        try
+        {   Convert::permute(S.view(View::all, View::all, 0), V, {0, 0});
+            return EXIT_FAILURE;
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+        try
+        {   Convert::permute(S.view(View::all, View::all, 0), V, {0, 1});
+            return EXIT_FAILURE;
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
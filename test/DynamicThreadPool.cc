@@ -0,0 +1,95 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/ThreadPool.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+//  Every valid element must be visited once, with its own indexes.
+
+template <typename Array>
+bool check(Irulan::ThreadPool& pool, Array& A, std::size_t block_bytes)
+{   for (std::size_t k = 0; k < A.size(); k++)
+        A()[k] = 0;
+    pool.for_each(A, [&A](auto& value, auto... i){ value += 1 + (&A(i...) - A()); }, block_bytes);
+    for (std::size_t k = 0; k < A.size(); k++)
+        if (A()[k] != static_cast<typename Array::value_type>(1 + k) && (Array::layout != Irulan::tiled || A()[k] != 0)) // tiles stick out
+            return false;
+    return true;
+}
+
+int main()
+{   using namespace Irulan;
+    ThreadPool pool {6};
+    if (pool.size() != 6)
+        return EXIT_FAILURE;
+
+    {   std::atomic<std::size_t> sum {0};
+        pool.run(1000, [&sum](std::size_t i){ sum += i; });
+        if (sum != 999 * 1000 / 2)
+            return EXIT_FAILURE;
+        pool.run(0, [](std::size_t){ std::abort(); });
+    }
+
+    //  Runs from other threads take turns.
+
+    {   std::atomic<std::size_t> sum {0};
+        auto runs = [&pool, &sum]()
+            {   for (int r = 0; r < 50; r++)
+                    pool.run(100, [&sum](std::size_t i){ sum += i; });
+            };
+        std::thread other {runs};
+        runs();
+        other.join();
+        if (sum != 100 * 99 * 100 / 2)
+            return EXIT_FAILURE;
+    }
+
+    //  Runs from tasks of the pool are made inline instead of waiting for threads that are all busy.
+
+    {   std::atomic<std::size_t> sum {0};
+        pool.run(10, [&pool, &sum](std::size_t i)
+            {   pool.run(10, [&sum, i](std::size_t j){ sum += 10 * i + j; });
+            });
+        if (sum != 99 * 100 / 2)
+            return EXIT_FAILURE;
+    }
+
+    try
+    {   pool.run(100, [](std::size_t i)
+            {   if (i == 42)
+                    throw std::runtime_error {"42"};
+            });
+        return EXIT_FAILURE;
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+
+    {   Dynamic::Array<long[3]> A {37, 11, 5};
+        Dynamic::Array<long[3], Axis<row>> B {37, 11, 5};
+        Dynamic::Array<long[3], Layout<packed_inc>> C {23};
+        Dynamic::Array<long[3], Layout<packed_dec>, Axis<row>> D {23};
+        Dynamic::Array<long[2], Layout<tiled>, Tile<4, 4>> E {13, 9};
+        for (std::size_t bytes : {std::size_t {64}, std::size_t {1000}, std::size_t {1} << 20})
+            if (!check(pool, A, bytes) || !check(pool, B, bytes) || !check(pool, C, bytes) || !check(pool, D, bytes) ||
+                !check(pool, E, bytes))
+                return EXIT_FAILURE;
+    }
+
+    //  Blocks span the fastest index first, and are split until there's enough of them.
+
+    {   const Dynamic::Array<float[3]> A {100, 100, 100};
+        std::atomic<std::size_t> blocks {0}, elements {0};
+        pool.for_blocks(A, [&](const Block<std::size_t, 3>& block)
+            {   if (block.end[0] - block.begin[0] != 100 || block.end[1] - block.begin[1] > 100)
+                    std::abort();
+                blocks++;
+                elements += (block.end[0] - block.begin[0]) * (block.end[1] - block.begin[1]) *
+                    (block.end[2] - block.begin[2]);
+            }, 40000);
+        if (blocks < 4 * pool.size() || elements != A.size())
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,46 @@
+#include "../include/Irulan/Dynamic.h"
+
+#include <cstdlib>
+#include <vector>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<int[2], Layout<tiled>, Tile<4, 2>> A {10, 5};
+        if (A.size() != 3 * 3 * 8)
+            return EXIT_FAILURE;
+
+        //  The 1st tile, then the next one along the 1st dim.
+        int *prev = A() - 1;
+        for (std::size_t j = 0; j < 2; j++)
+            for (std::size_t i = 0; i < 4; i++)
+            {   if (&A(i, j) != prev + 1)
+                    return EXIT_FAILURE;
+                prev = &A(i, j);
+            }
+        if (&A(4, 0) != A() + 8 || &A(0, 2) != A() + 3 * 8 || &A(9, 4) != A() + (2 + 2 * 3) * 8 + 1 + 0 * 4)
+            return EXIT_FAILURE;
+        if (&A(3) != &A(0, 3))
+            return EXIT_FAILURE;
+
+        //  Every element has its own place.
+        std::vector<int> seen(A.size());
+        for (std::size_t j = 0; j < A[1]; j++)
+            for (std::size_t i = 0; i < A[0]; i++)
+                if (seen[&A(i, j) - A()]++)
+                    return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[3], Layout<tiled>, Tile<2, 2, 2>, Axis<row>> A {4, 4, 4};
+        int *prev = A() - 1;
+        for (std::size_t i = 0; i < 2; i++)
+            for (std::size_t j = 0; j < 2; j++)
+                for (std::size_t k = 0; k < 2; k++)
+                {   if (&A(i, j, k) != prev + 1)
+                        return EXIT_FAILURE;
+                    prev = &A(i, j, k);
+                }
+        if (&A(0, 0, 2) != A() + 8 || &A(2, 0, 0) != A() + 4 * 8)
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,50 @@
+#include "../include/Irulan/Static.h"
+
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+
+    {   Static::Array<float[3][4][5], Axis<row>> A;
+
+        if (A() != (float *) &A(0) || A() != (float *) &A(0, 0) || A() != &A(0, 0, 0))
+            return EXIT_FAILURE;
+        if (A(1)[0] != 4 || A(1)[1] != 5)
+            return EXIT_FAILURE;
+
+        float *prev = A() - 1;
+        for (size_t i = 0; i < A[0]; i++)
+            for (size_t j = 0; j < A[1]; j++)
+                for (size_t k = 0; k < A[2]; k++)
+                {   if (&A(i, j, k) != prev + 1)
+                        return EXIT_FAILURE;
+                    prev = &A(i, j, k);
+                }
+    }
+
+    {   constexpr Static::Array<int[2][3], Axis<row>> A {{1, 2, 3}, {4, 5, 6}};
+        static_assert(A(0, 2) == 3 && A(1, 0) == 4);
+    }
+
+    {   Static::Array<int[4][4], Axis<row>, Layout<packed_inc>> A;
+        int *old = A() - 1;
+        for (size_t i = 0; i < A[0]; i++)
+            for (size_t j = 0; j <= i; j++)
+            {   if (old + 1 != &A(i, j))
+                    return EXIT_FAILURE;
+                old = &A(i, j);
+            }
+        if (&A(2) != &A(2, 0))
+            return EXIT_FAILURE;
+    }
+
+    {   Static::Array<int[4][4], Axis<row>, Layout<packed_dec>> A;
+        int *old = A() - 1;
+        for (size_t i = 0; i < A[0]; i++)
+            for (size_t j = i; j < A[0]; j++)
+            {   if (old + 1 != &A(i, j))
+                    return EXIT_FAILURE;
+                old = &A(i, j);
+            }
+    }
+}
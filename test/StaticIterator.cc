@@ -0,0 +1,28 @@
+#include "../include/Irulan/Static.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+
+    {   Static::Array<float[3][4]> A;
+        std::fill(A.begin(), A.end(), 1);
+        if (A.size() != 12 || A(2, 3) != 1)
+            return EXIT_FAILURE;
+        for (auto [index, value] : A.indexed())
+            if (&value != &A(index[0], index[1]))
+                return EXIT_FAILURE;
+    }
+
+    {   Static::Array<int[3][3][3], Layout<packed_dec>> A;
+        std::size_t n = 0;
+        for (auto [index, value] : A.indexed())
+        {   if (&value != &A(index[0], index[1], index[2]))
+                return EXIT_FAILURE;
+            n++;
+        }
+        if (n != 10)
+            return EXIT_FAILURE;
+    }
+}
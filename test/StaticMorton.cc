@@ -0,0 +1,14 @@
+#include "../include/Irulan/Static.h"
+
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+
+    {   Static::Array<double[3][4], Layout<morton>> A;
+        if (sizeof(A) != 16 * sizeof(double))
+            return EXIT_FAILURE;
+        if (&A(1, 1) != A() + 3 || &A(2, 3) != A() + 4 + 10 || &A(1) != &A(0, 1))
+            return EXIT_FAILURE;
+    }
+}
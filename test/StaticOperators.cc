@@ -1,5 +1,7 @@
 #include "../include/Irulan/Static.h"
 
+#include <cstdlib>
+
 int main()
 {   using namespace Irulan;
 
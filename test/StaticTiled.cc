@@ -0,0 +1,16 @@
+#include "../include/Irulan/Static.h"
+
+#include <cstdlib>
+
+int main()
+{   using namespace Irulan;
+
+    {   Static::Array<float[6][6], Layout<tiled>, Tile<4, 4>> A;
+        if (sizeof(A) != 4 * 16 * sizeof(float))
+            return EXIT_FAILURE;
+        if (&A(3, 3) != A() + 15 || &A(4, 0) != A() + 16 || &A(5, 5) != A() + 3 * 16 + 5)
+            return EXIT_FAILURE;
+        if (&A(1) != &A(0, 1))
+            return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,63 @@
+#include "../include/Irulan/Dynamic.h"
+#include "../include/Irulan/Static.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+int main()
+{   using namespace Irulan;
+
+    {   Dynamic::Array<int[3]> A {4, 5, 6};
+        for (std::size_t i = 0; i < A.size(); i++)
+            A()[i] = i;
+
+        auto V = A.view(View::Range {1, 3}, 2, View::all);
+        static_assert(decltype(V)::order == 2);
+        if (V[0] != 2 || V[1] != 6 || V() != &A(1, 2, 0))
+            return EXIT_FAILURE;
+        for (std::size_t k = 0; k < V[1]; k++)
+            for (std::size_t i = 0; i < V[0]; i++)
+                if (&V(i, k) != &A(1 + i, 2, k))
+                    return EXIT_FAILURE;
+        if (&V(1) != &V(0, 1))
+            return EXIT_FAILURE;
+
+        auto W = V.view(View::all, View::Range {0, 6, 2});
+        if (W[0] != 2 || W[1] != 3 || &W(1, 2) != &A(2, 2, 4))
+            return EXIT_FAILURE;
+
+        const auto& B = A;
+        auto C = B.view(0, View::all, View::all);
+        static_assert(std::is_same_v<decltype(C)::value_type, const int>);
+        if (&C(3, 5) != &A(0, 3, 5))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], Axis<row>> A {4, 5};
+        auto V = A.view(View::all, View::Range {1, 5, 3});
+        if (V[0] != 4 || V[1] != 2 || &V(3, 1) != &A(3, 4) || &V(2) != &A(2, 1))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2], EfficientShape<true>> A {4, 5};
+        auto V = A.view(View::all, View::Range {2, 5});
+        if (V[0] != 4 || V[1] != 3 || &V(1, 2) != &A(1, 4))
+            return EXIT_FAILURE;
+    }
+
+    {   Static::Array<float[3][4][5]> A;
+        auto V = A.view(View::all, 1, View::Range {1, 5, 2});
+        if (V[0] != 3 || V[1] != 2 || &V(2, 1) != &A(2, 1, 3))
+            return EXIT_FAILURE;
+    }
+
+    {   Dynamic::Array<int[2]> A {4, 5};
+        try
+        {   A.view(View::all, View::Range {0, 5, 0});
+            return EXIT_FAILURE;
+        }
+        catch (const std::invalid_argument&)
+        {
+        }
+    }
+}